@@ -0,0 +1,162 @@
+#include "Log.hpp"
+#include "MicroSDC.hpp"
+#include "StateHandler.hpp"
+#include "networking/NetworkConfig.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Implements a StateHandler for NumericStates which only provides the initial state
+class NumericStateHandler : public StateHandler
+{
+public:
+  /// @brief constructs a new NumericStateHandler attached to a given descriptor state handle
+  /// @param descriptor_handle the handle of the state's descriptor
+  explicit NumericStateHandler(const std::string& descriptor_handle)
+    : StateHandler(descriptor_handle)
+  {
+  }
+
+  std::shared_ptr<BICEPS::PM::AbstractState> get_initial_state() const override
+  {
+    return make_state(0);
+  }
+
+  BICEPS::MM::InvocationState request_state_change(const BICEPS::MM::AbstractSet& /*set*/) override
+  {
+    return BICEPS::MM::InvocationState::FAIL;
+  }
+
+  /// @brief constructs a new state of the metric holding a given value
+  /// @param value the value of the metric
+  /// @return pointer to the new state
+  std::shared_ptr<BICEPS::PM::NumericMetricState> make_state(const double value) const
+  {
+    auto state = std::make_shared<BICEPS::PM::NumericMetricState>(get_descriptor_handle());
+    state->metric_value = BICEPS::PM::NumericMetricValue(
+        BICEPS::PM::MetricQuality{BICEPS::PM::MeasurementValidity::VLD});
+    state->metric_value->value = value;
+    return state;
+  }
+
+  /// @brief sets a new value of the metric and updates the mdib
+  /// @param value the new value of the metric
+  void set_value(const double value)
+  {
+    update_state(make_state(value));
+  }
+};
+
+/// @brief creates a MicroSDC instance on the loopback interface holding numeric metrics
+/// @param metrics the number of numeric metrics in the mdib
+/// @param[out] handlers the state handlers of the metrics
+/// @return the configured instance, which is not yet started
+static std::shared_ptr<MicroSDC>
+create_device(const std::size_t metrics,
+              std::vector<std::shared_ptr<NumericStateHandler>>& handlers)
+{
+  auto sdc = std::make_shared<MicroSDC>();
+  sdc->set_network_config(std::make_unique<NetworkConfig>(false, "127.0.0.1", 0));
+  sdc->set_endpoint_reference("urn:uuid:7c3dd2b2-5a39-4b7e-9a51-4e5a1d6b1f00");
+
+  BICEPS::PM::ChannelDescriptor channel("channel");
+  for (std::size_t i = 0; i < metrics; ++i)
+  {
+    const auto handle = "metric" + std::to_string(i);
+    channel.metric.emplace_back(std::make_shared<BICEPS::PM::NumericMetricDescriptor>(
+        handle, BICEPS::PM::CodedValue("262688"), BICEPS::PM::MetricCategory::MSRMT,
+        BICEPS::PM::MetricAvailability::CONT, 1));
+    handlers.emplace_back(std::make_shared<NumericStateHandler>(handle));
+    sdc->add_md_state(handlers.back());
+  }
+  BICEPS::PM::VmdDescriptor vmd("vmd");
+  vmd.channel.emplace_back(channel);
+  BICEPS::PM::MdsDescriptor mds("mds");
+  mds.vmd.emplace_back(vmd);
+  BICEPS::PM::MdDescription md_description;
+  md_description.mds.emplace_back(mds);
+  sdc->set_md_description(md_description);
+  return sdc;
+}
+
+/// @brief measures single state updates, whose cost should not depend on the size of the mdib
+/// @param metrics the number of numeric metrics in the mdib
+/// @param updates the number of updates to measure
+static void benchmark_update_state(const std::size_t metrics, const std::size_t updates)
+{
+  std::vector<std::shared_ptr<NumericStateHandler>> handlers;
+  auto sdc = create_device(metrics, handlers);
+  sdc->start();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < updates; ++i)
+  {
+    const auto& handler = handlers[i % handlers.size()];
+    handler->set_value(static_cast<double>(i));
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  sdc->stop();
+  std::cout << "update_state, " << metrics << " states: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / updates
+            << " ns/update" << std::endl;
+}
+
+/// @brief measures the throughput of state updates by concurrent producers, each updating its own
+/// share of the states through their state handlers. Updates of all producers are serialized by
+/// the mdib writer lock and by the lock ordering their reports, so the throughput shows the cost
+/// of this contention.
+/// @param metrics the number of numeric metrics in the mdib
+/// @param producers the number of threads updating states
+/// @param updates the number of updates per producer
+static void benchmark_concurrent_updates(const std::size_t metrics, const std::size_t producers,
+                                         const std::size_t updates)
+{
+  std::vector<std::shared_ptr<NumericStateHandler>> handlers;
+  auto sdc = create_device(metrics, handlers);
+  sdc->start();
+
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t producer = 0; producer < producers; ++producer)
+  {
+    threads.emplace_back([&, producer]() {
+      for (std::size_t i = 0; i < updates; ++i)
+      {
+        const auto& handler = handlers[(i * producers + producer) % handlers.size()];
+        handler->set_value(static_cast<double>(i));
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  sdc->stop();
+  const auto seconds = std::chrono::duration<double>(duration).count();
+  // the latency a producer sees grows with the time it waits for the other producers
+  std::cout << "StateHandler::update_state, " << producers << " producers, " << metrics
+            << " states: " << static_cast<std::size_t>(producers * updates / seconds)
+            << " updates/s, "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / updates
+            << " ns/update per producer" << std::endl;
+}
+
+int main()
+{
+  Log::set_log_level(LogLevel::ERROR);
+  for (const std::size_t metrics : {10, 100, 1000, 10000})
+  {
+    benchmark_update_state(metrics, 20000);
+  }
+  for (const std::size_t producers : {1, 2, 4, 8})
+  {
+    benchmark_concurrent_updates(1000, producers, 20000 / producers);
+  }
+  return 0;
+}
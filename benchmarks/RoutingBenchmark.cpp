@@ -0,0 +1,130 @@
+#include "MetadataProvider.hpp"
+#include "server_http.hpp"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Server = SimpleWeb::Server<SimpleWeb::HTTP>;
+using Handler = std::function<void(std::shared_ptr<Server::Response>,
+                                   std::shared_ptr<Server::Request>)>;
+
+/// @brief gets the paths of the services MicroSDC registers, extended by further services
+/// @param services the number of services
+/// @return the paths of the services
+static std::vector<std::string> service_paths(const std::size_t services)
+{
+  std::vector<std::string> paths{MetadataProvider::get_device_service_path(),
+                                 MetadataProvider::get_get_service_path(),
+                                 MetadataProvider::get_get_service_path() + "/wsdl",
+                                 MetadataProvider::get_set_service_path(),
+                                 MetadataProvider::get_set_service_path() + "/wsdl",
+                                 MetadataProvider::get_state_event_service_path(),
+                                 MetadataProvider::get_state_event_service_path() + "/wsdl"};
+  for (std::size_t i = paths.size(); i < services; ++i)
+  {
+    paths.emplace_back("/MicroSDC/Service" + std::to_string(i));
+  }
+  paths.resize(services);
+  return paths;
+}
+
+/// @brief dispatches requests round robin to all services and prints the time per request
+/// @param name the name of the measurement
+/// @param paths the paths of the registered services
+/// @param iterations the number of requests to dispatch
+/// @param dispatch dispatches a POST request for a given path and returns whether it was found
+static void benchmark_dispatch(const std::string& name, const std::vector<std::string>& paths,
+                               const std::size_t iterations,
+                               const std::function<bool(const std::string&)>& dispatch)
+{
+  std::size_t dispatched = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    dispatched += dispatch(paths[i % paths.size()]) ? 1 : 0;
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+  if (dispatched != iterations)
+  {
+    std::cout << name << ": " << iterations - dispatched << " requests not dispatched"
+              << std::endl;
+  }
+  std::cout << name << ", " << paths.size() << " services: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / iterations
+            << " ns/request" << std::endl;
+}
+
+/// @brief measures matching requests against every service registered as ^uri$ resource, the way
+/// Simple-Web-Server finds the resource of a request
+/// @param services the number of registered services
+/// @param iterations the number of requests to dispatch
+static void benchmark_regex(const std::size_t services, const std::size_t iterations)
+{
+  const auto paths = service_paths(services);
+  std::size_t handled = 0;
+  const Handler handler = [&handled](std::shared_ptr<Server::Response> /*response*/,
+                                     std::shared_ptr<Server::Request> /*request*/) { ++handled; };
+  Server server;
+  for (const auto& path : paths)
+  {
+    server.resource["^" + path + "$"]["GET"] = handler;
+    server.resource["^" + path + "$"]["POST"] = handler;
+  }
+  const std::string method("POST");
+  benchmark_dispatch("std::regex resources", paths, iterations, [&](const std::string& path) {
+    for (auto& regex_method : server.resource)
+    {
+      const auto method_handler = regex_method.second.find(method);
+      if (method_handler == regex_method.second.end())
+      {
+        continue;
+      }
+      SimpleWeb::regex::smatch match;
+      if (SimpleWeb::regex::regex_match(path, match, regex_method.first))
+      {
+        method_handler->second(nullptr, nullptr);
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
+/// @brief measures looking up requests in the routing table of WebServerSimple
+/// @param services the number of registered services
+/// @param iterations the number of requests to dispatch
+static void benchmark_routes(const std::size_t services, const std::size_t iterations)
+{
+  const auto paths = service_paths(services);
+  std::size_t handled = 0;
+  const Handler handler = [&handled](std::shared_ptr<Server::Response> /*response*/,
+                                     std::shared_ptr<Server::Request> /*request*/) { ++handled; };
+  std::unordered_map<std::string, Handler> routes;
+  for (const auto& path : paths)
+  {
+    routes[path] = handler;
+  }
+  benchmark_dispatch("hash map routes", paths, iterations, [&](const std::string& path) {
+    const auto route = routes.find(path);
+    if (route == routes.end())
+    {
+      return false;
+    }
+    route->second(nullptr, nullptr);
+    return true;
+  });
+}
+
+int main()
+{
+  for (const std::size_t services : {7, 100})
+  {
+    benchmark_regex(services, 200000);
+    benchmark_routes(services, 200000);
+  }
+  return 0;
+}
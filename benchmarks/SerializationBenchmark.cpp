@@ -0,0 +1,281 @@
+#include "SDCConstants.hpp"
+#include "datamodel/MessageSerializer.hpp"
+#include "datamodel/XmlWriter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// the number of heap allocations made by the process
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(const std::size_t size)
+{
+  ++allocations;
+  if (void* memory = std::malloc(size == 0 ? 1 : size))
+  {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void* memory, const std::size_t /*size*/) noexcept
+{
+  std::free(memory);
+}
+
+/// @brief constructs a numeric metric state holding a given value
+/// @param handle the handle of the metric's descriptor
+/// @param value the value of the metric
+/// @return pointer to the new state
+static std::shared_ptr<BICEPS::PM::NumericMetricState> make_state(const std::string& handle,
+                                                                  const double value)
+{
+  auto state = std::make_shared<BICEPS::PM::NumericMetricState>(handle);
+  state->metric_value = BICEPS::PM::NumericMetricValue(
+      BICEPS::PM::MetricQuality{BICEPS::PM::MeasurementValidity::VLD});
+  state->metric_value->value = value;
+  return state;
+}
+
+/// @brief constructs a mdib holding numeric metrics in one channel
+/// @param metrics the number of numeric metrics in the mdib
+/// @return the new mdib
+static std::shared_ptr<const BICEPS::PM::Mdib> create_mdib(const std::size_t metrics)
+{
+  BICEPS::PM::ChannelDescriptor channel("channel");
+  BICEPS::PM::MdState md_state;
+  for (std::size_t i = 0; i < metrics; ++i)
+  {
+    const auto handle = "metric" + std::to_string(i);
+    channel.metric.emplace_back(std::make_shared<BICEPS::PM::NumericMetricDescriptor>(
+        handle, BICEPS::PM::CodedValue("262688"), BICEPS::PM::MetricCategory::MSRMT,
+        BICEPS::PM::MetricAvailability::CONT, 1));
+    md_state.state.push_back(make_state(handle, 0.1 * static_cast<double>(i)));
+  }
+  BICEPS::PM::VmdDescriptor vmd("vmd");
+  vmd.channel.emplace_back(channel);
+  BICEPS::PM::MdsDescriptor mds("mds");
+  mds.vmd.emplace_back(vmd);
+  BICEPS::PM::MdDescription md_description;
+  md_description.mds.emplace_back(mds);
+
+  auto mdib = std::make_shared<BICEPS::PM::Mdib>(
+      BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
+  mdib->mdib_version_group.mdib_version = 1;
+  mdib->md_description = std::make_shared<const BICEPS::PM::MdDescription>(md_description);
+  mdib->md_state = std::move(md_state);
+  return mdib;
+}
+
+/// @brief checks that a serialized value is a valid xs:decimal which reads back to the original
+/// @param name the name of the checked value
+/// @param xml the serialized XML
+/// @param attribute the name of the attribute holding the value
+/// @param values the expected values, separated by spaces in the attribute
+/// @return whether the attribute holds the values in decimal notation
+static bool check_decimals(const std::string& name, const std::string& xml,
+                           const std::string& attribute, const std::vector<double>& values)
+{
+  const auto begin = xml.find(" " + attribute + "=\"");
+  if (begin == std::string::npos)
+  {
+    std::cout << name << ": missing " << attribute << std::endl;
+    return false;
+  }
+  const auto value_begin = begin + attribute.size() + 3;
+  const auto text = xml.substr(value_begin, xml.find('"', value_begin) - value_begin);
+  const char* token = text.c_str();
+  for (const auto value : values)
+  {
+    while (*token == ' ')
+    {
+      ++token;
+    }
+    char* token_end = nullptr;
+    const auto parsed = std::strtod(token, &token_end);
+    const std::string written(token, static_cast<const char*>(token_end));
+    if (written.find_first_not_of("-.0123456789") != std::string::npos || parsed != value)
+    {
+      std::cout << name << ": " << value << " written as \"" << written << "\"" << std::endl;
+      return false;
+    }
+    token = token_end;
+  }
+  return true;
+}
+
+/// @brief checks that numbers of small and large magnitudes are written in decimal notation, as
+/// the shortest representation of floating point numbers might use an exponent
+/// @return whether all numbers were written as valid xs:decimal
+static bool check_decimal_notation()
+{
+  const std::vector<double> values{1e-7,
+                                   -2.5e-12,
+                                   0.1,
+                                   123456.789,
+                                   1e22,
+                                   -3.25e100,
+                                   std::numeric_limits<double>::max(),
+                                   std::numeric_limits<double>::denorm_min()};
+  bool valid = true;
+  for (const auto value : values)
+  {
+    MessageSerializer serializer;
+    serializer.serialize_state(*make_state("metric", value));
+    valid &= check_decimals("NumericMetricValue", serializer.str(), "Value", {value});
+  }
+
+  BICEPS::PM::RealTimeSampleArrayMetricState state("waveform");
+  state.metric_value = BICEPS::PM::SampleArrayValue(
+      BICEPS::PM::MetricQuality{BICEPS::PM::MeasurementValidity::VLD});
+  state.metric_value->samples = values;
+  MessageSerializer serializer;
+  serializer.serialize_state(state);
+  valid &= check_decimals("SampleArrayValue", serializer.str(), "Samples", values);
+  return valid;
+}
+
+/// @brief serializes a given envelope repeatedly and prints the time, the allocations and the size
+/// per message
+/// @param name the name of the measurement
+/// @param envelope the message to serialize
+/// @param iterations the number of messages to serialize
+static void benchmark_envelope(const std::string& name, const MESSAGEMODEL::Envelope& envelope,
+                               const std::size_t iterations)
+{
+  std::size_t bytes = 0;
+  const auto allocations_before = allocations.load();
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    MessageSerializer serializer;
+    serializer.serialize(envelope);
+    bytes += serializer.str().size();
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+  const auto seconds = std::chrono::duration<double>(duration).count();
+  std::cout << name << ": "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / iterations
+            << " ns/message, " << (allocations.load() - allocations_before) / iterations
+            << " allocations/message, " << bytes / iterations << " bytes/message, "
+            << static_cast<std::size_t>(static_cast<double>(bytes) / seconds / 1e6) << " MB/s"
+            << std::endl;
+}
+
+/// @brief measures the serialization of a full GetMdibResponse
+/// @param metrics the number of numeric metrics in the mdib
+/// @param iterations the number of messages to serialize
+static void benchmark_get_mdib(const std::size_t metrics, const std::size_t iterations)
+{
+  const auto mdib = create_mdib(metrics);
+  BICEPS::PM::MdibVersionGroup version_group{WS::ADDRESSING::URIType("0")};
+  version_group.mdib_version = 1;
+  MESSAGEMODEL::Envelope envelope;
+  envelope.header.action = WS::ADDRESSING::URIType(SDC::ACTION_GET_MDIB_RESPONSE);
+  envelope.header.message_id = WS::ADDRESSING::URIType("urn:uuid:benchmark");
+  envelope.body.get_mdib_response = BICEPS::MM::GetMdibResponse(version_group, mdib);
+  benchmark_envelope("GetMdibResponse, " + std::to_string(metrics) + " states", envelope,
+                     iterations);
+}
+
+/// @brief measures the serialization of an EpisodicMetricReport
+/// @param metrics the number of metric states in the report
+/// @param iterations the number of messages to serialize
+static void benchmark_episodic_metric_report(const std::size_t metrics,
+                                             const std::size_t iterations)
+{
+  BICEPS::MM::MetricReportPart report_part;
+  for (std::size_t i = 0; i < metrics; ++i)
+  {
+    report_part.metric_state.emplace_back(
+        make_state("metric" + std::to_string(i), 0.1 * static_cast<double>(i)));
+  }
+  BICEPS::MM::EpisodicMetricReport report(
+      BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
+  report.mdib_version_group.mdib_version = 1;
+  report.report_part.emplace_back(std::move(report_part));
+  MESSAGEMODEL::Envelope envelope;
+  envelope.header.action = WS::ADDRESSING::URIType(SDC::ACTION_EPISODIC_METRIC_REPORT);
+  envelope.header.message_id = WS::ADDRESSING::URIType("urn:uuid:benchmark");
+  envelope.body.episodic_metric_report = std::move(report);
+  benchmark_envelope("EpisodicMetricReport, " + std::to_string(metrics) + " states", envelope,
+                     iterations);
+}
+
+/// @brief measures formatting sample arrays as done for every waveform frame and
+/// RealTimeSampleArrayMetricState
+/// @param samples the number of samples per array
+/// @param precision the number of fractional digits written, or none for round-trip values
+/// @param iterations the number of arrays to format
+static void benchmark_samples(const std::size_t samples, const std::optional<int> precision,
+                              const std::size_t iterations)
+{
+  std::vector<double> values(samples);
+  for (std::size_t i = 0; i < samples; ++i)
+  {
+    values[i] = 1.5 * std::sin(0.05 * static_cast<double>(i));
+  }
+  std::size_t bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    XmlWriter writer(samples * 24);
+    writer.start_element("pm:MetricValue");
+    writer.list_attribute("Samples", values, precision);
+    writer.end_element();
+    bytes += writer.str().size();
+  }
+  const auto seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Samples, " << samples << " per array, "
+            << (precision.has_value() ? std::to_string(precision.value()) + " fractional digits"
+                                      : std::string("round-trip"))
+            << ": "
+            << static_cast<std::size_t>(static_cast<double>(samples * iterations) / seconds)
+            << " samples/s, " << bytes / iterations << " bytes/array, "
+            << static_cast<std::size_t>(static_cast<double>(bytes) / seconds / 1e6) << " MB/s"
+            << std::endl;
+}
+
+// Release build, same machine, ns/message and allocations/message:
+//                                  DOM serializer (e250521)   streaming serializer
+// GetMdibResponse, 10 states       30205 / 40                 11145 / 3
+// GetMdibResponse, 100 states      530829 / 287               95766 / 6
+// GetMdibResponse, 1000 states     4433442 / 2733             1428116 / 9
+// GetMdibResponse, 5000 states     18412473 / 13592           4506332 / 11
+// EpisodicMetricReport, 1 state    10016 / 12                 1083 / 2
+// EpisodicMetricReport, 10 states  25276 / 29                 4876 / 2
+int main()
+{
+  if (!check_decimal_notation())
+  {
+    return 1;
+  }
+  for (const std::size_t metrics : {10, 100, 1000, 5000})
+  {
+    benchmark_get_mdib(metrics, std::max<std::size_t>(100000 / metrics, 50));
+  }
+  for (const std::size_t metrics : {1, 10})
+  {
+    benchmark_episodic_metric_report(metrics, 100000);
+  }
+  for (const auto precision : {std::optional<int>(), std::optional<int>(3)})
+  {
+    benchmark_samples(100, precision, 100000);
+  }
+  return 0;
+}
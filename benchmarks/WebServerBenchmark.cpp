@@ -0,0 +1,161 @@
+#include "Log.hpp"
+#include "MetadataProvider.hpp"
+#include "MicroSDC.hpp"
+#include "StateHandler.hpp"
+#include "client_http.hpp"
+#include "networking/NetworkConfig.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// GetMdib request as sent by a consumer
+static const std::string GET_MDIB_REQUEST =
+    R"(<?xml version="1.0" encoding="utf-8"?>)"
+    R"(<s12:Envelope xmlns:s12="http://www.w3.org/2003/05/soap-envelope")"
+    R"( xmlns:wsa="http://www.w3.org/2005/08/addressing">)"
+    R"(<s12:Header>)"
+    R"(<wsa:Action>http://standards.ieee.org/downloads/11073/11073-20701-2018/GetService/GetMdib)"
+    R"(</wsa:Action>)"
+    R"(<wsa:MessageID>urn:uuid:3f0c7b8e-2d51-4a77-9a51-9c1d5b2e4a10</wsa:MessageID>)"
+    R"(<wsa:To>http://127.0.0.1:8080/MicroSDC/GetService</wsa:To>)"
+    R"(</s12:Header>)"
+    R"(<s12:Body>)"
+    R"(<msg:GetMdib)"
+    R"( xmlns:msg="http://standards.ieee.org/downloads/11073/11073-10207-2017/message"/>)"
+    R"(</s12:Body>)"
+    R"(</s12:Envelope>)";
+
+/// @brief Implements a StateHandler for NumericStates which only provides the initial state
+class NumericStateHandler : public StateHandler
+{
+public:
+  /// @brief constructs a new NumericStateHandler attached to a given descriptor state handle
+  /// @param descriptor_handle the handle of the state's descriptor
+  explicit NumericStateHandler(const std::string& descriptor_handle)
+    : StateHandler(descriptor_handle)
+  {
+  }
+
+  std::shared_ptr<BICEPS::PM::AbstractState> get_initial_state() const override
+  {
+    auto state = std::make_shared<BICEPS::PM::NumericMetricState>(get_descriptor_handle());
+    state->metric_value = BICEPS::PM::NumericMetricValue(
+        BICEPS::PM::MetricQuality{BICEPS::PM::MeasurementValidity::VLD});
+    state->metric_value->value = 0;
+    return state;
+  }
+
+  BICEPS::MM::InvocationState request_state_change(const BICEPS::MM::AbstractSet& /*set*/) override
+  {
+    return BICEPS::MM::InvocationState::FAIL;
+  }
+};
+
+/// @brief creates a MicroSDC instance on the loopback interface holding numeric metrics
+/// @param metrics the number of numeric metrics in the mdib
+/// @param worker_threads the number of threads of the web server handling requests
+/// @return the configured instance, which is not yet started
+static std::shared_ptr<MicroSDC> create_device(const std::size_t metrics,
+                                               const std::size_t worker_threads)
+{
+  auto sdc = std::make_shared<MicroSDC>();
+  auto network_config = std::make_unique<NetworkConfig>(false, "127.0.0.1", 8080);
+  network_config->set_worker_threads(worker_threads);
+  sdc->set_network_config(std::move(network_config));
+  sdc->set_endpoint_reference("urn:uuid:7c3dd2b2-5a39-4b7e-9a51-4e5a1d6b1f00");
+
+  BICEPS::PM::ChannelDescriptor channel("channel");
+  for (std::size_t i = 0; i < metrics; ++i)
+  {
+    const auto handle = "metric" + std::to_string(i);
+    channel.metric.emplace_back(std::make_shared<BICEPS::PM::NumericMetricDescriptor>(
+        handle, BICEPS::PM::CodedValue("262688"), BICEPS::PM::MetricCategory::MSRMT,
+        BICEPS::PM::MetricAvailability::CONT, 1));
+    sdc->add_md_state(std::make_shared<NumericStateHandler>(handle));
+  }
+  BICEPS::PM::VmdDescriptor vmd("vmd");
+  vmd.channel.emplace_back(channel);
+  BICEPS::PM::MdsDescriptor mds("mds");
+  mds.vmd.emplace_back(vmd);
+  BICEPS::PM::MdDescription md_description;
+  md_description.mds.emplace_back(mds);
+  sdc->set_md_description(md_description);
+  return sdc;
+}
+
+/// @brief measures the throughput of GetMdib requests sent by concurrent consumers, each on its own
+/// keep-alive connection
+/// @param worker_threads the number of threads of the web server handling requests
+/// @param clients the number of concurrent consumers
+/// @param requests the number of requests per consumer
+static void benchmark_get_mdib(const std::size_t worker_threads, const std::size_t clients,
+                               const std::size_t requests)
+{
+  auto sdc = create_device(1000, worker_threads);
+  sdc->start();
+
+  std::atomic<std::size_t> failed{0};
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < clients; ++i)
+  {
+    threads.emplace_back([&]() {
+      SimpleWeb::Client<SimpleWeb::HTTP> client("127.0.0.1:8080");
+      for (std::size_t request = 0; request < requests; ++request)
+      {
+        try
+        {
+          const auto response = client.request("POST", MetadataProvider::get_get_service_path(),
+                                               GET_MDIB_REQUEST);
+          if (response->status_code.compare(0, 3, "200") != 0)
+          {
+            ++failed;
+          }
+        }
+        catch (const SimpleWeb::system_error& /*e*/)
+        {
+          ++failed;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  sdc->stop();
+  const auto seconds = std::chrono::duration<double>(duration).count();
+  std::cout << "GetMdib, 1000 states, " << worker_threads << " worker threads, " << clients
+            << " clients: "
+            << static_cast<std::size_t>(static_cast<double>(clients * requests) / seconds)
+            << " requests/s";
+  if (failed.load() > 0)
+  {
+    std::cout << ", " << failed.load() << " failed";
+  }
+  std::cout << std::endl;
+}
+
+int main()
+{
+  Log::set_log_level(LogLevel::ERROR);
+  // the same load for every pool size, so the throughput shows how requests scale over the cores
+  const std::size_t cores = std::max(4U, std::thread::hardware_concurrency());
+  std::cout << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+  for (std::size_t worker_threads = 1;; worker_threads = std::min(2 * worker_threads, cores))
+  {
+    benchmark_get_mdib(worker_threads, cores, 2000 / cores);
+    if (worker_threads == cores)
+    {
+      break;
+    }
+  }
+  return 0;
+}
@@ -1,16 +1,23 @@
 #include "ClientSession.esp.hpp"
 #include "Log.hpp"
+#include <algorithm>
+#include <stdexcept>
 
 #include "esp_http_client.h"
 
-std::unique_ptr<ClientSessionInterface> ClientSessionFactory::produce(const std::string& address,
-                                                                      const bool use_tls)
+static constexpr const char* TAG = "ClientSession";
+
+std::shared_ptr<ClientSessionInterface>
+ClientSessionFactory::produce(const std::string& address, const bool use_tls,
+                              const ClientSessionConfig& config)
 {
-  return std::make_unique<ClientSessionEsp32>(address, use_tls);
+  return std::make_shared<ClientSessionEsp32>(address, use_tls, config);
 }
 
-ClientSessionEsp32::ClientSessionEsp32(std::string notify_to, const bool use_tls)
+ClientSessionEsp32::ClientSessionEsp32(std::string notify_to, const bool use_tls,
+                                       const ClientSessionConfig& config)
   : notify_to_(std::move(notify_to))
+  , config_(config)
 {
   extern const char serverCrtStart[] asm("_binary_server_crt_start");
   extern const char serverKeyStart[] asm("_binary_server_key_start");
@@ -25,6 +32,8 @@ ClientSessionEsp32::ClientSessionEsp32(std::string notify_to, const bool use_tls
   }
   config.keep_alive_enable = true;
   config.keep_alive_idle = 30;
+  config.timeout_ms =
+      static_cast<int>(std::chrono::milliseconds(config_.request_timeout).count());
   config.method = HTTP_METHOD_POST;
   config.transport_type = HTTP_TRANSPORT_OVER_TCP;
   session_ = esp_http_client_init(&config);
@@ -45,16 +54,70 @@ ClientSessionEsp32::~ClientSessionEsp32()
 
 void ClientSessionEsp32::send(const std::string& message)
 {
+  ++pending_;
+  try
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    perform(message);
+  }
+  catch (const std::exception&)
+  {
+    --pending_;
+    throw;
+  }
+  --pending_;
+}
+
+void ClientSessionEsp32::perform(const std::string& message)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now < retry_time_)
+  {
+    throw std::runtime_error("Connection to " + notify_to_ + " is backing off");
+  }
+  if (now - last_used_ > config_.idle_timeout)
+  {
+    // do not reuse a connection the client might have closed while it was idle
+    esp_http_client_close(session_);
+  }
   esp_http_client_set_post_field(session_, message.c_str(), message.length());
   esp_err_t err = esp_http_client_perform(session_);
-  if (err == ESP_OK)
+  last_used_ = std::chrono::steady_clock::now();
+  if (err != ESP_OK)
   {
-    LOG(LogLevel::DEBUG, "HTTPS Status = " << esp_http_client_get_status_code(session_)
-                                           << " , content_length = "
-                                           << esp_http_client_get_content_length(session_));
+    LOG(LogLevel::ERROR, "Error perform http request " << esp_err_to_name(err));
+    backoff_ = backoff_.count() == 0 ? config_.initial_backoff
+                                     : std::min(backoff_ * 2, config_.max_backoff);
+    retry_time_ = last_used_ + backoff_;
+    throw std::runtime_error("Failed to deliver message to " + notify_to_);
   }
-  else
+  backoff_ = std::chrono::milliseconds{0};
+  const auto status = esp_http_client_get_status_code(session_);
+  LOG(LogLevel::DEBUG, "HTTPS Status = " << status << " , content_length = "
+                                         << esp_http_client_get_content_length(session_));
+  if (status < 200 || status >= 300)
   {
-    LOG(LogLevel::ERROR, "Error perform http request " << esp_err_to_name(err));
+    throw std::runtime_error(notify_to_ + " responded with status " + std::to_string(status));
   }
 }
+
+void ClientSessionEsp32::send_async(std::shared_ptr<const std::string> message,
+                                    Completion completion)
+{
+  bool delivered = true;
+  try
+  {
+    send(*message);
+  }
+  catch (const std::exception& e)
+  {
+    LOG(LogLevel::ERROR, e.what());
+    delivered = false;
+  }
+  completion(delivered);
+}
+
+std::size_t ClientSessionEsp32::pending() const
+{
+  return pending_.load();
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "ClientSession/SessionManager.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 struct esp_http_client;
 
@@ -10,17 +13,41 @@ public:
   /// @brief Constructs a new ClientSession
   /// @param notifyTo the address to connect this session to
   /// @param useTls whether to use TLS encrypted communication
-  explicit ClientSessionEsp32(std::string notify_to, bool use_tls);
+  /// @param config the connection parameters of this session
+  explicit ClientSessionEsp32(std::string notify_to, bool use_tls,
+                              const ClientSessionConfig& config);
   ClientSessionEsp32(const ClientSessionEsp32&) = delete;
   ClientSessionEsp32(ClientSessionEsp32&&) = delete;
   ClientSessionEsp32& operator=(const ClientSessionEsp32&) = delete;
   ClientSessionEsp32& operator=(ClientSessionEsp32&&) = delete;
   ~ClientSessionEsp32() override;
   void send(const std::string& message) override;
+  /// @brief sends a message synchronously, as esp_http_client cannot pipeline requests, and calls
+  /// the completion afterwards
+  void send_async(std::shared_ptr<const std::string> message, Completion completion) override;
+
+  std::size_t pending() const override;
 
 private:
   /// pointer to the esp http session instance
   esp_http_client* session_{};
   /// the address this session is connected to
   const std::string notify_to_;
+  /// the connection parameters of this session
+  const ClientSessionConfig config_;
+  /// mutex serializing requests on session_
+  std::mutex mutex_;
+  /// the time the last request completed
+  std::chrono::steady_clock::time_point last_used_;
+  /// the time to wait before the next connection attempt
+  std::chrono::milliseconds backoff_{0};
+  /// requests are rejected until this point in time
+  std::chrono::steady_clock::time_point retry_time_;
+  /// the number of messages being sent or waiting for mutex_
+  std::atomic<std::size_t> pending_{0};
+
+  /// @brief performs one request, serialized by the caller
+  /// @param message the message to post
+  /// @throws std::runtime_error if the message could not be delivered
+  void perform(const std::string& message);
 };
@@ -9,7 +9,7 @@
 #include <array>
 #include <memory>
 #include <string>
-#include <vector>
+#include <utility>
 
 std::unique_ptr<WebServerInterface>
 WebServerFactory::produce(const std::shared_ptr<const NetworkConfig>& networkConfig)
@@ -71,16 +71,14 @@ void WebServerEsp32::add_service(std::shared_ptr<ServiceInterface> service)
 
 esp_err_t WebServerEsp32::handler_callback(httpd_req_t* req)
 {
-  std::vector<char> buffer;
-  buffer.resize(req->content_len + 1);
+  // receive straight into the string handed to the request, which keeps it null-terminated
+  std::string buffer(req->content_len, '\0');
   size_t received = httpd_req_recv(req, buffer.data(), req->content_len);
   if (received != req->content_len)
   {
     LOG(LogLevel::ERROR, "Could not receive all bytes!");
     return ESP_FAIL;
   }
-  // null-terminate the buffer
-  buffer.emplace_back('\0');
   LOG(LogLevel::DEBUG, "Received " << std::to_string(received) << " of "
                                    << std::to_string(req->content_len) << " bytes: \n"
                                    << buffer.data());
@@ -98,8 +96,7 @@ esp_err_t WebServerEsp32::handler_callback(httpd_req_t* req)
 
   try
   {
-    (*service)->handle_request(
-        std::make_unique<RequestEsp32>(req, std::string(buffer.begin(), buffer.end())));
+    (*service)->handle_request(std::make_unique<RequestEsp32>(req, std::move(buffer)));
   }
   catch (rapidxml::parse_error& e)
   {
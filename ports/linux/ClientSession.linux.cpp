@@ -1,11 +1,680 @@
 #include "ClientSession.linux.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <future>
+#include <istream>
+#include <type_traits>
 
-std::unique_ptr<ClientSessionInterface> ClientSessionFactory::produce(const std::string& address,
-                                                                      const bool use_tls)
+static constexpr const char* TAG = "ClientSession";
+
+/// whether sessions of the given socket type communicate TLS encrypted
+template <typename SocketType>
+static constexpr bool IS_TLS = std::is_same_v<SocketType, HttpsSocket>;
+
+std::shared_ptr<ClientSessionInterface>
+ClientSessionFactory::produce(const std::string& address, const bool use_tls,
+                              const ClientSessionConfig& config)
 {
   if (use_tls)
   {
-    return std::make_unique<ClientSessionSimple<SimpleWeb::HTTPS>>(address);
+    return std::make_shared<ClientSessionSimple<HttpsSocket>>(address, config);
+  }
+  return std::make_shared<ClientSessionSimple<HttpSocket>>(address, config);
+}
+
+ClientContext::ClientContext()
+  : work_guard_(asio::make_work_guard(io_context_))
+  , thread_([this]() {
+    while (true)
+    {
+      try
+      {
+        io_context_.run();
+        return;
+      }
+      catch (const std::exception& e)
+      {
+        LOG(LogLevel::ERROR, "Unhandled exception in client session: " << e.what());
+      }
+    }
+  })
+{
+}
+
+ClientContext::~ClientContext()
+{
+  work_guard_.reset();
+  io_context_.stop();
+  thread_.join();
+}
+
+ClientContext& ClientContext::instance()
+{
+  static ClientContext context;
+  return context;
+}
+
+asio::io_context& ClientContext::io_context()
+{
+  return io_context_;
+}
+
+asio::ssl::context& ClientContext::ssl_context()
+{
+  std::call_once(ssl_context_flag_, [this]() {
+    auto context = std::make_unique<asio::ssl::context>(asio::ssl::context::tlsv13);
+    context->use_certificate_chain_file("certs/server.crt");
+    context->use_private_key_file("certs/server.key", asio::ssl::context::pem);
+    context->load_verify_file("certs/ca.crt");
+    context->set_verify_mode(asio::ssl::verify_none);
+    ssl_context_ = std::move(context);
+  });
+  return *ssl_context_;
+}
+
+std::shared_ptr<SSL_SESSION> ClientContext::get_tls_session(const std::string& host) const
+{
+  std::lock_guard<std::mutex> lock(tls_sessions_mutex_);
+  const auto session = tls_sessions_.find(host);
+  return session != tls_sessions_.end() ? session->second : nullptr;
+}
+
+void ClientContext::store_tls_session(const std::string& host, SSL* ssl)
+{
+  auto* current = SSL_get0_session(ssl);
+  if (current == nullptr || SSL_SESSION_is_resumable(current) == 0)
+  {
+    return;
+  }
+  // cache a copy, as OpenSSL invalidates the session of a connection closed without shutdown
+  std::shared_ptr<SSL_SESSION> session(SSL_SESSION_dup(current), SSL_SESSION_free);
+  if (session == nullptr)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(tls_sessions_mutex_);
+  tls_sessions_[host] = std::move(session);
+}
+
+template <typename SocketType>
+ClientSessionSimple<SocketType>::ClientSessionSimple(const std::string& address,
+                                                     const ClientSessionConfig& config)
+  : address_(address)
+  , config_(config)
+  , resolver_(ClientContext::instance().io_context())
+  , timeout_timer_(ClientContext::instance().io_context())
+  , idle_timer_(ClientContext::instance().io_context())
+{
+  if constexpr (IS_TLS<SocketType>)
+  {
+    // load the certificates now to report a misconfiguration to the creator of this session
+    ClientContext::instance().ssl_context();
+  }
+  // split http(s)://host[:port][/path]
+  const auto scheme_end = address_.find("://");
+  const auto authority_begin = scheme_end == std::string::npos ? 0 : scheme_end + 3;
+  const auto path_begin = address_.find('/', authority_begin);
+  host_header_ = address_.substr(authority_begin, path_begin - authority_begin);
+  path_ = path_begin == std::string::npos ? "/" : address_.substr(path_begin);
+  const auto port_begin = host_header_.rfind(':');
+  const auto ipv6_end = host_header_.rfind(']');
+  if (port_begin != std::string::npos && (ipv6_end == std::string::npos || port_begin > ipv6_end))
+  {
+    host_ = host_header_.substr(0, port_begin);
+    port_ = host_header_.substr(port_begin + 1);
+  }
+  else
+  {
+    host_ = host_header_;
+    port_ = IS_TLS<SocketType> ? "443" : "80";
+  }
+  if (host_.size() > 1 && host_.front() == '[' && host_.back() == ']')
+  {
+    host_ = host_.substr(1, host_.size() - 2);
   }
-  return std::make_unique<ClientSessionSimple<SimpleWeb::HTTP>>(address);
+  request_header_ = "POST " + path_ + " HTTP/1.1\r\nHost: " + host_header_ +
+                    "\r\nContent-Type: application/soap+xml; charset=utf-8\r\nContent-Length: ";
 }
+
+template <typename SocketType>
+ClientSessionSimple<SocketType>::~ClientSessionSimple()
+{
+  fail(awaiting_response_);
+  fail(queue_);
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::send(const std::string& message)
+{
+  // the completion is called on the client context thread, which would wait for itself
+  if (ClientContext::instance().io_context().get_executor().running_in_this_thread())
+  {
+    throw std::runtime_error("Cannot wait for the delivery to " + address_ +
+                             " on the client session thread");
+  }
+  auto delivered = std::make_shared<std::promise<bool>>();
+  auto result = delivered->get_future();
+  send_async(std::make_shared<const std::string>(message),
+             [delivered](const bool success) { delivered->set_value(success); });
+  if (!result.get())
+  {
+    throw std::runtime_error("Failed to deliver message to " + address_);
+  }
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::send_async(std::shared_ptr<const std::string> message,
+                                                 Completion completion)
+{
+  ++pending_;
+  asio::post(ClientContext::instance().io_context(),
+             [self = this->shared_from_this(), message = std::move(message),
+              completion = std::move(completion)]() mutable {
+               // completions are only called by this session, so it outlives them
+               auto* const session = self.get();
+               self->queue_.push_back(Request{std::move(message),
+                                              [session, completion](const bool delivered) {
+                                                --session->pending_;
+                                                completion(delivered);
+                                              },
+                                              {}});
+               self->process();
+             });
+}
+
+template <typename SocketType>
+std::size_t ClientSessionSimple<SocketType>::pending() const
+{
+  return pending_.load();
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::process()
+{
+  if (!connected_)
+  {
+    if (connecting_ || queue_.empty())
+    {
+      return;
+    }
+    if (std::chrono::steady_clock::now() < retry_time_)
+    {
+      LOG(LogLevel::WARNING, "Connection to " << address_ << " is backing off. Discarding "
+                                              << queue_.size() << " message(s)");
+      fail(queue_);
+      return;
+    }
+    connect();
+    return;
+  }
+  if (!writing_ && !queue_.empty() &&
+      awaiting_response_.size() < std::max<std::size_t>(config_.max_requests_in_flight, 1))
+  {
+    write();
+  }
+  start_idle_timeout();
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::connect()
+{
+  auto& io_context = ClientContext::instance().io_context();
+  if constexpr (IS_TLS<SocketType>)
+  {
+    socket_ = std::make_shared<SocketType>(io_context, ClientContext::instance().ssl_context());
+  }
+  else
+  {
+    socket_ = std::make_shared<SocketType>(io_context);
+  }
+  connecting_ = true;
+  reused_ = false;
+  timed_out_ = false;
+  response_buffer_.consume(response_buffer_.size());
+  start_timeout();
+  resolver_.async_resolve(
+      host_, port_,
+      [self = this->shared_from_this(), id = connection_id_, socket = socket_](
+          const std::error_code& ec, const asio::ip::tcp::resolver::results_type& endpoints) {
+        if (id != self->connection_id_)
+        {
+          return;
+        }
+        if (ec)
+        {
+          self->on_connection_error(ec);
+          return;
+        }
+        asio::async_connect(
+            socket->lowest_layer(), endpoints,
+            [self, id, socket](const std::error_code& ec,
+                               const asio::ip::tcp::endpoint& /*unused*/) {
+              if (id != self->connection_id_)
+              {
+                return;
+              }
+              if (ec)
+              {
+                self->on_connection_error(ec);
+                return;
+              }
+              asio::error_code option_ec;
+              socket->lowest_layer().set_option(asio::ip::tcp::no_delay(true), option_ec);
+              if constexpr (IS_TLS<SocketType>)
+              {
+                self->handshake();
+              }
+              else
+              {
+                self->on_connected();
+              }
+            });
+      });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::handshake()
+{
+  if constexpr (IS_TLS<SocketType>)
+  {
+    auto* ssl = socket_->native_handle();
+    SSL_set_tlsext_host_name(ssl, host_.c_str());
+    const auto tls_session = ClientContext::instance().get_tls_session(host_header_);
+    if (tls_session != nullptr)
+    {
+      SSL_set_session(ssl, tls_session.get());
+    }
+    socket_->async_handshake(
+        asio::ssl::stream_base::client,
+        [self = this->shared_from_this(), id = connection_id_,
+         socket = socket_](const std::error_code& ec) {
+          if (id != self->connection_id_)
+          {
+            return;
+          }
+          if (ec)
+          {
+            self->on_connection_error(ec);
+            return;
+          }
+          LOG(LogLevel::DEBUG, (SSL_session_reused(socket->native_handle()) == 1 ? "Resumed"
+                                                                                  : "Negotiated")
+                                   << " TLS session with " << self->address_);
+          self->on_connected();
+        });
+  }
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::on_connected()
+{
+  LOG(LogLevel::DEBUG, "Connected to " << address_);
+  connecting_ = false;
+  connected_ = true;
+  timeout_timer_.cancel();
+  process();
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::on_connection_error(const std::error_code& ec)
+{
+  // a keep-alive connection might have been closed by the client while idle, so requests sent on
+  // a reused connection are retried once on a new connection
+  const bool retry = reused_ && !timed_out_;
+  if (retry)
+  {
+    LOG(LogLevel::INFO, "Reconnecting to " << address_ << ": " << ec.message());
+  }
+  else
+  {
+    LOG(LogLevel::ERROR, "Connection to " << address_ << " failed: "
+                                          << (timed_out_ ? "timeout" : ec.message()));
+  }
+  close();
+  std::deque<Request> retries;
+  for (auto& request : awaiting_response_)
+  {
+    if (retry && !request.retried)
+    {
+      request.retried = true;
+      retries.emplace_back(std::move(request));
+    }
+    else
+    {
+      request.completion(false);
+    }
+  }
+  awaiting_response_.clear();
+  queue_.insert(queue_.begin(), std::make_move_iterator(retries.begin()),
+                std::make_move_iterator(retries.end()));
+  if (!retry)
+  {
+    backoff_ = backoff_.count() == 0 ? config_.initial_backoff
+                                     : std::min(backoff_ * 2, config_.max_backoff);
+    retry_time_ = std::chrono::steady_clock::now() + backoff_;
+    LOG(LogLevel::WARNING,
+        "Not reconnecting to " << address_ << " for " << backoff_.count() << " ms");
+  }
+  process();
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::write()
+{
+  auto& request = awaiting_response_.emplace_back(std::move(queue_.front()));
+  queue_.pop_front();
+  if (request.content_length.empty())
+  {
+    request.content_length = std::to_string(request.message->size()) + "\r\n\r\n";
+  }
+  writing_ = true;
+  idle_timer_.cancel();
+  if (awaiting_response_.size() == 1)
+  {
+    start_timeout();
+  }
+  // the message is shared by all sessions it is sent to and written without copying it
+  const std::array<asio::const_buffer, 3> buffers{asio::buffer(request_header_),
+                                                  asio::buffer(request.content_length),
+                                                  asio::buffer(*request.message)};
+  asio::async_write(*socket_, buffers,
+                    [self = this->shared_from_this(), id = connection_id_,
+                     socket = socket_](const std::error_code& ec, std::size_t /*unused*/) {
+                      if (id != self->connection_id_)
+                      {
+                        return;
+                      }
+                      self->writing_ = false;
+                      if (ec)
+                      {
+                        self->on_connection_error(ec);
+                        return;
+                      }
+                      if (!self->reading_)
+                      {
+                        self->read_response();
+                      }
+                      self->process();
+                    });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::read_response()
+{
+  reading_ = true;
+  asio::async_read_until(
+      *socket_, response_buffer_, "\r\n\r\n",
+      [self = this->shared_from_this(), id = connection_id_,
+       socket = socket_](const std::error_code& ec, std::size_t /*unused*/) {
+        if (id != self->connection_id_)
+        {
+          return;
+        }
+        if (ec)
+        {
+          self->on_connection_error(ec);
+          return;
+        }
+        std::istream stream(&self->response_buffer_);
+        const auto header = parse_header(stream);
+        if (header.chunked)
+        {
+          self->read_chunk(header);
+          return;
+        }
+        self->skip(header.content_length, [self, header]() { self->on_response(header); });
+      });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::read_chunk(const ResponseHeader& header)
+{
+  asio::async_read_until(
+      *socket_, response_buffer_, "\r\n",
+      [self = this->shared_from_this(), id = connection_id_, socket = socket_,
+       header](const std::error_code& ec, std::size_t /*unused*/) {
+        if (id != self->connection_id_)
+        {
+          return;
+        }
+        if (ec)
+        {
+          self->on_connection_error(ec);
+          return;
+        }
+        std::istream stream(&self->response_buffer_);
+        std::string line;
+        std::getline(stream, line);
+        const auto chunk_size = std::strtoul(line.c_str(), nullptr, 16);
+        if (chunk_size == 0)
+        {
+          self->read_trailer(header);
+          return;
+        }
+        // skip the chunk data and its terminating CRLF
+        self->skip(chunk_size + 2, [self, header]() { self->read_chunk(header); });
+      });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::read_trailer(const ResponseHeader& header)
+{
+  asio::async_read_until(
+      *socket_, response_buffer_, "\r\n",
+      [self = this->shared_from_this(), id = connection_id_, socket = socket_,
+       header](const std::error_code& ec, std::size_t /*unused*/) {
+        if (id != self->connection_id_)
+        {
+          return;
+        }
+        if (ec)
+        {
+          self->on_connection_error(ec);
+          return;
+        }
+        std::istream stream(&self->response_buffer_);
+        std::string line;
+        std::getline(stream, line);
+        if (line.empty() || line == "\r")
+        {
+          self->on_response(header);
+          return;
+        }
+        self->read_trailer(header);
+      });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::skip(const std::size_t length, std::function<void()> next)
+{
+  if (response_buffer_.size() >= length)
+  {
+    response_buffer_.consume(length);
+    next();
+    return;
+  }
+  asio::async_read(*socket_, response_buffer_,
+                   asio::transfer_exactly(length - response_buffer_.size()),
+                   [self = this->shared_from_this(), id = connection_id_, socket = socket_, length,
+                    next = std::move(next)](const std::error_code& ec, std::size_t /*unused*/) {
+                     if (id != self->connection_id_)
+                     {
+                       return;
+                     }
+                     if (ec)
+                     {
+                       self->on_connection_error(ec);
+                       return;
+                     }
+                     self->response_buffer_.consume(length);
+                     next();
+                   });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::on_response(const ResponseHeader& header)
+{
+  reading_ = false;
+  auto request = std::move(awaiting_response_.front());
+  awaiting_response_.pop_front();
+  if constexpr (IS_TLS<SocketType>)
+  {
+    if (!reused_)
+    {
+      ClientContext::instance().store_tls_session(host_header_, socket_->native_handle());
+    }
+  }
+  reused_ = true;
+  backoff_ = std::chrono::milliseconds{0};
+  const bool delivered = header.status >= 200 && header.status < 300;
+  if (!delivered)
+  {
+    LOG(LogLevel::WARNING, address_ << " responded with status " << header.status);
+  }
+  if (header.close)
+  {
+    close();
+    // requests written after the closing response were not processed by the client
+    queue_.insert(queue_.begin(), std::make_move_iterator(awaiting_response_.begin()),
+                  std::make_move_iterator(awaiting_response_.end()));
+    awaiting_response_.clear();
+  }
+  else if (!awaiting_response_.empty())
+  {
+    start_timeout();
+    read_response();
+  }
+  else
+  {
+    timeout_timer_.cancel();
+  }
+  request.completion(delivered);
+  process();
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::close()
+{
+  ++connection_id_;
+  connecting_ = false;
+  connected_ = false;
+  writing_ = false;
+  reading_ = false;
+  resolver_.cancel();
+  timeout_timer_.cancel();
+  idle_timer_.cancel();
+  if (socket_ != nullptr)
+  {
+    asio::error_code ec;
+    socket_->lowest_layer().close(ec);
+    socket_.reset();
+  }
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::fail(std::deque<Request>& requests)
+{
+  auto failed = std::move(requests);
+  requests.clear();
+  for (auto& request : failed)
+  {
+    request.completion(false);
+  }
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::start_timeout()
+{
+  timeout_timer_.expires_after(config_.request_timeout);
+  timeout_timer_.async_wait(
+      [weak = this->weak_from_this(), id = connection_id_](const std::error_code& ec) {
+        auto self = weak.lock();
+        if (ec || self == nullptr || id != self->connection_id_)
+        {
+          return;
+        }
+        // aborts the pending operation, which then reports the timeout
+        self->timed_out_ = true;
+        self->resolver_.cancel();
+        asio::error_code close_ec;
+        self->socket_->lowest_layer().close(close_ec);
+      });
+}
+
+template <typename SocketType>
+void ClientSessionSimple<SocketType>::start_idle_timeout()
+{
+  if (!connected_ || writing_ || !queue_.empty() || !awaiting_response_.empty())
+  {
+    return;
+  }
+  idle_timer_.expires_after(config_.idle_timeout);
+  idle_timer_.async_wait(
+      [weak = this->weak_from_this(), id = connection_id_](const std::error_code& ec) {
+        auto self = weak.lock();
+        if (ec || self == nullptr || id != self->connection_id_)
+        {
+          return;
+        }
+        LOG(LogLevel::DEBUG, "Closing idle connection to " << self->address_);
+        self->close();
+      });
+}
+
+template <typename SocketType>
+typename ClientSessionSimple<SocketType>::ResponseHeader
+ClientSessionSimple<SocketType>::parse_header(std::istream& stream)
+{
+  const auto to_lower = [](std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return text;
+  };
+  ResponseHeader header;
+  std::string version;
+  stream >> version >> header.status;
+  std::string line;
+  // skip the reason phrase
+  std::getline(stream, line);
+  header.close = version == "HTTP/1.0";
+  bool has_content_length = false;
+  while (std::getline(stream, line) && !line.empty() && line != "\r")
+  {
+    const auto colon = line.find(':');
+    if (colon == std::string::npos)
+    {
+      continue;
+    }
+    const auto name = to_lower(line.substr(0, colon));
+    const auto value_begin = line.find_first_not_of(' ', colon + 1);
+    const auto value = to_lower(value_begin == std::string::npos
+                                    ? std::string()
+                                    : line.substr(value_begin, line.find('\r') - value_begin));
+    if (name == "content-length")
+    {
+      header.content_length = std::strtoul(value.c_str(), nullptr, 10);
+      has_content_length = true;
+    }
+    else if (name == "transfer-encoding")
+    {
+      header.chunked = value.find("chunked") != std::string::npos;
+    }
+    else if (name == "connection")
+    {
+      header.close = value.find("close") != std::string::npos;
+    }
+  }
+  // a body delimited by the end of the connection is not awaited, the connection is closed instead
+  if (!has_content_length && !header.chunked && header.status >= 200 && header.status != 204 &&
+      header.status != 304)
+  {
+    header.close = true;
+  }
+  return header;
+}
+
+template class ClientSessionSimple<HttpSocket>;
+template class ClientSessionSimple<HttpsSocket>;
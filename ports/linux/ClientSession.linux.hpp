@@ -1,37 +1,225 @@
 #pragma once
 
-#include "ClientSession/SessionManager.hpp"
-#include "Log.hpp"
-#include "client_https.hpp"
-#include <regex>
+#include "ClientSession/ClientSession.hpp"
+#include <asio.hpp>
+#include <asio/ssl.hpp>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
 
-template <typename SocketType>
-class ClientSessionSimple : public ClientSessionInterface
+using HttpSocket = asio::ip::tcp::socket;
+using HttpsSocket = asio::ssl::stream<asio::ip::tcp::socket>;
+
+/// @brief ClientContext runs the network operations of all client sessions on one thread and
+/// holds the TLS configuration and the resumable TLS sessions shared between them
+class ClientContext
 {
 public:
-  explicit ClientSessionSimple(const std::string& address);
+  ClientContext(const ClientContext&) = delete;
+  ClientContext(ClientContext&&) = delete;
+  ClientContext& operator=(const ClientContext&) = delete;
+  ClientContext& operator=(ClientContext&&) = delete;
+  ~ClientContext();
 
-  void send(const std::string& message) override;
+  /// @brief gets the process wide client context and starts its thread on first use
+  /// @return the client context
+  static ClientContext& instance();
+
+  /// @brief gets the io context all client sessions run on
+  /// @return reference to the io context
+  asio::io_context& io_context();
+
+  /// @brief gets the TLS context of all client sessions and loads the certificates on first use
+  /// @return reference to the TLS context
+  asio::ssl::context& ssl_context();
+
+  /// @brief gets the TLS session last negotiated with a host to resume it on a new connection
+  /// @param host the host and port of the server
+  /// @return the TLS session or nullptr if none is cached
+  std::shared_ptr<SSL_SESSION> get_tls_session(const std::string& host) const;
+
+  /// @brief caches the TLS session of a connection if it is resumable
+  /// @param host the host and port of the server
+  /// @param ssl the connection to take the session from
+  void store_tls_session(const std::string& host, SSL* ssl);
 
 private:
-  SimpleWeb::Client<SocketType> client_;
+  ClientContext();
+
+  /// io context of all client sessions
+  asio::io_context io_context_;
+  /// keeps the io context running while no operation is pending
+  asio::executor_work_guard<asio::io_context::executor_type> work_guard_;
+  /// thread running the io context
+  std::thread thread_;
+  /// ensures the TLS context is created once
+  std::once_flag ssl_context_flag_;
+  /// TLS context of all client sessions
+  std::unique_ptr<asio::ssl::context> ssl_context_;
+  /// mutex protecting tls_sessions_
+  mutable std::mutex tls_sessions_mutex_;
+  /// resumable TLS sessions, host->session
+  std::map<std::string, std::shared_ptr<SSL_SESSION>> tls_sessions_;
 };
 
-template <>
-inline ClientSessionSimple<SimpleWeb::HTTPS>::ClientSessionSimple(const std::string& address)
-  : client_(std::regex_replace(address, std::regex("http(s)?://"), ""), false, "certs/server.crt",
-            "certs/server.key", "certs/ca.crt")
+/// @brief ClientSessionSimple holds one keep-alive HTTP/1.1 connection to a client. Messages are
+/// pipelined in order on the ClientContext thread. The connection is established on demand,
+/// closed after being idle and re-established with exponential backoff after failures.
+template <typename SocketType>
+class ClientSessionSimple : public ClientSessionInterface,
+                            public std::enable_shared_from_this<ClientSessionSimple<SocketType>>
 {
-}
+public:
+  /// @brief constructs a new session without connecting
+  /// @param address the address of the client
+  /// @param config the connection parameters of this session
+  ClientSessionSimple(const std::string& address, const ClientSessionConfig& config);
+  ClientSessionSimple(const ClientSessionSimple&) = delete;
+  ClientSessionSimple(ClientSessionSimple&&) = delete;
+  ClientSessionSimple& operator=(const ClientSessionSimple&) = delete;
+  ClientSessionSimple& operator=(ClientSessionSimple&&) = delete;
+  ~ClientSessionSimple() override;
 
-template <>
-inline ClientSessionSimple<SimpleWeb::HTTP>::ClientSessionSimple(const std::string& address)
-  : client_(std::regex_replace(address, std::regex("http(s)?://"), ""))
-{
-}
+  void send(const std::string& message) override;
 
-template <typename SocketType>
-void ClientSessionSimple<SocketType>::send(const std::string& message)
-{
-  client_.request("POST", "", message);
-}
+  void send_async(std::shared_ptr<const std::string> message, Completion completion) override;
+
+  std::size_t pending() const override;
+
+private:
+  /// @brief Request is a message waiting for delivery
+  struct Request
+  {
+    /// the message to post
+    std::shared_ptr<const std::string> message;
+    /// called with whether the message was delivered
+    Completion completion;
+    /// the value of the Content-Length header, terminating the request header
+    std::string content_length;
+    /// whether this request was already sent on a connection which broke
+    bool retried{false};
+  };
+
+  /// @brief ResponseHeader holds the fields of a HTTP response header relevant to this session
+  struct ResponseHeader
+  {
+    /// the status code of the response
+    unsigned int status{0};
+    /// the length of the response body, if known
+    std::size_t content_length{0};
+    /// whether the body is sent in chunks
+    bool chunked{false};
+    /// whether the server closes the connection after this response
+    bool close{false};
+  };
+
+  /// the address of the client
+  const std::string address_;
+  /// the connection parameters of this session
+  const ClientSessionConfig config_;
+  /// the host name or ip address of the client
+  std::string host_;
+  /// the port of the client
+  std::string port_;
+  /// the host and port as sent in the Host header
+  std::string host_header_;
+  /// the path to post messages to
+  std::string path_;
+  /// the request header up to the Content-Length value, which is the same for every message
+  std::string request_header_;
+  /// resolves the host of the client
+  asio::ip::tcp::resolver resolver_;
+  /// the socket of the current connection
+  std::shared_ptr<SocketType> socket_;
+  /// limits the time to connect and to await a response
+  asio::steady_timer timeout_timer_;
+  /// closes the connection after being idle
+  asio::steady_timer idle_timer_;
+  /// received response data
+  asio::streambuf response_buffer_;
+  /// requests waiting to be written
+  std::deque<Request> queue_;
+  /// requests written and awaiting their response
+  std::deque<Request> awaiting_response_;
+  /// incremented for every connection to discard completions of closed connections
+  std::size_t connection_id_{0};
+  /// whether a connection is being established
+  bool connecting_{false};
+  /// whether the current connection is established
+  bool connected_{false};
+  /// whether a request is being written
+  bool writing_{false};
+  /// whether a response is being read
+  bool reading_{false};
+  /// whether the current connection already completed a request
+  bool reused_{false};
+  /// whether the current connection was closed because the server did not respond in time
+  bool timed_out_{false};
+  /// the time to wait before the next connection attempt
+  std::chrono::milliseconds backoff_{0};
+  /// connection attempts are rejected until this point in time
+  std::chrono::steady_clock::time_point retry_time_;
+  /// the number of messages sent whose completion was not called yet
+  std::atomic<std::size_t> pending_{0};
+
+  /// @brief connects if needed and writes queued requests while less than
+  /// max_requests_in_flight are awaiting their response
+  void process();
+
+  /// @brief resolves the host of the client and opens a new connection
+  void connect();
+
+  /// @brief performs the TLS handshake, resuming a cached TLS session if possible
+  void handshake();
+
+  /// @brief marks the connection established and starts writing queued requests
+  void on_connected();
+
+  /// @brief closes the connection and fails all requests after the connection broke
+  /// @param ec the error which broke the connection
+  void on_connection_error(const std::error_code& ec);
+
+  /// @brief writes the next queued request
+  void write();
+
+  /// @brief reads the header of the next response
+  void read_response();
+
+  /// @brief reads the body of the response in chunks
+  /// @param header the header of the response
+  void read_chunk(const ResponseHeader& header);
+
+  /// @brief reads the trailer following the last chunk of a response
+  /// @param header the header of the response
+  void read_trailer(const ResponseHeader& header);
+
+  /// @brief makes sure a given number of bytes was received, discards them and continues
+  /// @param length the number of bytes to discard
+  /// @param next the function to continue with
+  void skip(std::size_t length, std::function<void()> next);
+
+  /// @brief completes the oldest request awaiting a response
+  /// @param header the header of its response
+  void on_response(const ResponseHeader& header);
+
+  /// @brief closes the current connection, if any
+  void close();
+
+  /// @brief fails all queued requests
+  /// @param requests the requests to fail
+  static void fail(std::deque<Request>& requests);
+
+  /// @brief restarts the timeout of the current connection attempt or request
+  void start_timeout();
+
+  /// @brief starts to wait for the idle timeout if no request is pending
+  void start_idle_timeout();
+
+  /// @brief parses the header of a received response
+  /// @param stream the stream of the received data positioned at the response header
+  /// @return the parsed header
+  static ResponseHeader parse_header(std::istream& stream);
+};
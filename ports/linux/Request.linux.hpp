@@ -3,6 +3,7 @@
 #include "Log.hpp"
 #include "WebServer/Request.hpp"
 #include "server_https.hpp"
+#include <asio.hpp>
 
 template <class SocketType>
 class RequestSimple : public Request
@@ -19,6 +20,12 @@ public:
 private:
   void send_response(const std::string& msg) const override;
 
+  /// @brief null-terminates the content received into the request's streambuf, so that it can be
+  /// parsed in place without copying it
+  /// @param request the request whose content to terminate
+  /// @return pointer to the contiguous content inside the streambuf
+  static char* terminate_content(typename SimpleWeb::Server<SocketType>::Request& request);
+
   const std::shared_ptr<typename SimpleWeb::Server<SocketType>::Response> response_;
   const std::shared_ptr<const typename SimpleWeb::Server<SocketType>::Request> request_;
 };
@@ -27,12 +34,23 @@ template <class SocketType>
 RequestSimple<SocketType>::RequestSimple(
     std::shared_ptr<typename SimpleWeb::Server<SocketType>::Response> response,
     std::shared_ptr<typename SimpleWeb::Server<SocketType>::Request> request)
-  : Request(request->content.string())
+  : Request(terminate_content(*request))
   , response_(std::move(response))
   , request_(std::move(request))
 {
 }
 
+template <class SocketType>
+char* RequestSimple<SocketType>::terminate_content(
+    typename SimpleWeb::Server<SocketType>::Request& request)
+{
+  auto& streambuf = static_cast<asio::streambuf&>(*request.content.rdbuf());
+  asio::buffer_copy(streambuf.prepare(1), asio::buffer("", 1));
+  streambuf.commit(1);
+  // the streambuf stores its input sequence contiguously, the content is consumed by the parser
+  return const_cast<char*>(static_cast<const char*>(streambuf.data().data()));
+}
+
 template <class SocketType>
 void RequestSimple<SocketType>::send_response(const std::string& msg) const
 {
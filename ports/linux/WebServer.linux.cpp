@@ -6,17 +6,18 @@ WebServerFactory::produce(const std::shared_ptr<const NetworkConfig>& network_co
 {
   if (network_config->is_using_tls())
   {
-    return std::make_unique<WebServerSimple<SimpleWeb::HTTPS>>();
+    return std::make_unique<WebServerSimple<SimpleWeb::HTTPS>>(network_config->worker_threads());
   }
-  return std::make_unique<WebServerSimple<SimpleWeb::HTTP>>();
+  return std::make_unique<WebServerSimple<SimpleWeb::HTTP>>(network_config->worker_threads());
 }
 
 template <>
-WebServerSimple<SimpleWeb::HTTPS>::WebServerSimple()
+WebServerSimple<SimpleWeb::HTTPS>::WebServerSimple(const std::size_t worker_threads)
   : server_(std::make_unique<SimpleWeb::Server<SimpleWeb::HTTPS>>(
         "./certs/server.crt", "./certs/server.key", "./certs/ca.crt"))
 {
   server_->config.port = 8080;
+  server_->config.thread_pool_size = worker_threads;
   server_->config.timeout_content = 0;
   server_->config.timeout_request = 0;
   server_->on_error = [](std::shared_ptr<SimpleWeb::Server<SimpleWeb::HTTPS>::Request> /*request*/,
@@ -26,10 +27,11 @@ WebServerSimple<SimpleWeb::HTTPS>::WebServerSimple()
 }
 
 template <>
-WebServerSimple<SimpleWeb::HTTP>::WebServerSimple()
+WebServerSimple<SimpleWeb::HTTP>::WebServerSimple(const std::size_t worker_threads)
   : server_(std::make_unique<SimpleWeb::Server<SimpleWeb::HTTP>>())
 {
   server_->config.port = 8080;
+  server_->config.thread_pool_size = worker_threads;
   // server_->config.timeout_content = 10;
   // server_->config.timeout_request = 10;
 }
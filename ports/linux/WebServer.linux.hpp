@@ -6,7 +6,10 @@
 #include "rapidxml.hpp"
 #include "server_https.hpp"
 #include "services/ServiceInterface.hpp"
+#include <functional>
 #include <future>
+#include <string>
+#include <unordered_map>
 
 class ServiceInterface;
 
@@ -14,7 +17,9 @@ template <class SocketType>
 class WebServerSimple : public WebServerInterface
 {
 public:
-  explicit WebServerSimple();
+  /// @brief constructs a new WebServerSimple
+  /// @param worker_threads the number of threads handling requests
+  explicit WebServerSimple(std::size_t worker_threads);
   WebServerSimple(const WebServerSimple& other) = delete;
   WebServerSimple& operator=(const WebServerSimple& other) = delete;
   WebServerSimple(WebServerSimple&& other) = delete;
@@ -26,13 +31,35 @@ public:
   void add_service(std::shared_ptr<ServiceInterface> service) override;
 
 private:
+  using ServerResponse = std::shared_ptr<typename SimpleWeb::Server<SocketType>::Response>;
+  using ServerRequest = std::shared_ptr<typename SimpleWeb::Server<SocketType>::Request>;
+  using Handler = std::function<void(ServerResponse, ServerRequest)>;
+
   std::unique_ptr<SimpleWeb::Server<SocketType>> server_;
+  /// handlers of the services with a plain path, path->handler. Only modified before start, so
+  /// concurrent requests read it without locking.
+  std::unordered_map<std::string, Handler> routes_;
+  /// runs the server, which handles requests on this and worker_threads - 1 further threads
   std::thread server_thread_{};
 };
 
 template <class SocketType>
 void WebServerSimple<SocketType>::start()
 {
+  // requests not matching any service URI pattern are routed by their exact path
+  const auto route = [this](ServerResponse response, ServerRequest request) {
+    const auto handler = routes_.find(request->path);
+    if (handler == routes_.end())
+    {
+      LOG(LogLevel::WARNING, "No service found for path " << request->path);
+      response->write(SimpleWeb::StatusCode::client_error_not_found);
+      return;
+    }
+    handler->second(std::move(response), std::move(request));
+  };
+  server_->default_resource["GET"] = route;
+  server_->default_resource["POST"] = route;
+
   // Start server and receive assigned port when server is listening for requests
   std::promise<std::uint16_t> server_port;
   server_thread_ = std::thread([this, &server_port]() {
@@ -45,6 +72,11 @@ void WebServerSimple<SocketType>::start()
 template <class SocketType>
 void WebServerSimple<SocketType>::stop()
 {
+  // stop is called again on destruction
+  if (!server_thread_.joinable())
+  {
+    return;
+  }
   server_->stop();
   LOG(LogLevel::INFO, "Server stopping...");
   server_thread_.join();
@@ -79,6 +111,14 @@ void WebServerSimple<SocketType>::add_service(std::shared_ptr<ServiceInterface>
           LOG(LogLevel::ERROR, "Error while handling request!");
         }
       };
-  server_->resource["^" + service->get_uri() + "$"]["GET"] = handler;
-  server_->resource["^" + service->get_uri() + "$"]["POST"] = handler;
+  const auto uri = service->get_uri();
+  // Simple-Web-Server tries every regular expression for each request, so plain paths are looked
+  // up in a hash map instead and only patterns are registered as regular expressions
+  if (uri.find_first_of("^$.*+?()[]{}|\\") == std::string::npos)
+  {
+    routes_[uri] = handler;
+    return;
+  }
+  server_->resource["^" + uri + "$"]["GET"] = handler;
+  server_->resource["^" + uri + "$"]["POST"] = handler;
 }
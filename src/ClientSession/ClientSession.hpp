@@ -1,25 +1,71 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <string>
+
+/// @brief ClientSessionConfig holds the connection parameters of client sessions
+struct ClientSessionConfig
+{
+  /// maximum number of sessions, and thus connections, opened to the same address
+  std::size_t max_connections_per_host{2};
+  /// time after which an unused keep-alive connection is closed
+  std::chrono::seconds idle_timeout{30};
+  /// maximum number of requests written to a connection before their responses arrived. Requests
+  /// are answered in order, so pipelining keeps the order of messages sent through one session
+  std::size_t max_requests_in_flight{4};
+  /// time allowed for establishing a connection and for awaiting a response
+  std::chrono::seconds request_timeout{10};
+  /// time to wait before reconnecting after a failed connection. Doubled with every further
+  /// failure until max_backoff is reached
+  std::chrono::milliseconds initial_backoff{250};
+  /// upper bound of the time to wait before reconnecting
+  std::chrono::milliseconds max_backoff{30000};
+};
 
 /// @brief ClientSessionInterface defines an interface to a client session
 class ClientSessionInterface
 {
 public:
+  /// @brief Completion is called with whether a message sent asynchronously was delivered
+  using Completion = std::function<void(bool)>;
+
   ClientSessionInterface() = default;
   ClientSessionInterface(const ClientSessionInterface&) = default;
   ClientSessionInterface(ClientSessionInterface&&) = default;
   ClientSessionInterface& operator=(const ClientSessionInterface&) = default;
   ClientSessionInterface& operator=(ClientSessionInterface&&) = default;
   virtual ~ClientSessionInterface() = default;
-  /// @brief sends a given data message string the this client
+  /// @brief sends a given data message string the this client and waits for the response. Sessions
+  /// are safe to be used by several threads, but send must not be called from a completion.
   /// @param message the message to send
+  /// @throws std::runtime_error if the message could not be delivered
   virtual void send(const std::string& message) = 0;
+
+  /// @brief queues a message for delivery to this client without waiting for the response.
+  /// Messages are delivered in the order they were queued and up to max_requests_in_flight of them
+  /// are outstanding at a time.
+  /// @param message the message to send, which is kept alive until it was delivered
+  /// @param completion called with whether the message was delivered. It might be called on the
+  /// network thread of the session and must not block.
+  virtual void send_async(std::shared_ptr<const std::string> message, Completion completion) = 0;
+
+  /// @brief gets the number of messages sent through this session which are not completed yet
+  /// @return the number of pending messages
+  virtual std::size_t pending() const = 0;
 };
 
 
 class ClientSessionFactory
 {
 public:
-  static std::unique_ptr<ClientSessionInterface> produce(const std::string& address, bool use_tls);
+  /// @brief creates a new session holding a keep-alive connection to a given address
+  /// @param address the address of the client
+  /// @param use_tls whether to use TLS encrypted communication
+  /// @param config the connection parameters of the session
+  /// @return the new session
+  static std::shared_ptr<ClientSessionInterface>
+  produce(const std::string& address, bool use_tls, const ClientSessionConfig& config);
 };
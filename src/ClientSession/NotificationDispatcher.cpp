@@ -0,0 +1,254 @@
+#include "NotificationDispatcher.hpp"
+#include "Log.hpp"
+#include <algorithm>
+
+static constexpr const char* TAG = "NotificationDispatcher";
+
+NotificationDispatcher::NotificationDispatcher(const std::size_t num_threads,
+                                               const std::size_t max_pending,
+                                               const OverflowPolicy policy,
+                                               const std::size_t max_in_flight,
+                                               const std::chrono::milliseconds drain_timeout)
+  : max_pending_(std::max<std::size_t>(max_pending, 1))
+  , policy_(policy)
+  , max_in_flight_(std::max<std::size_t>(max_in_flight, 1))
+  , drain_timeout_(drain_timeout)
+  , completion_target_(std::make_shared<CompletionTarget>())
+{
+  completion_target_->dispatcher = this;
+  threads_.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    threads_.emplace_back([this]() { run(); });
+  }
+}
+
+NotificationDispatcher::~NotificationDispatcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_condition_.notify_all();
+  for (auto& thread : threads_)
+  {
+    thread.join();
+  }
+  {
+    // the sessions might never complete their messages, e.g. if their network thread stopped
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!idle_condition_.wait_for(lock, drain_timeout_, [this]() { return in_flight_ == 0; }))
+    {
+      LOG(LogLevel::WARNING, "Discarding " << in_flight_ << " notifications in flight");
+    }
+  }
+  std::lock_guard<std::mutex> lock(completion_target_->mutex);
+  completion_target_->dispatcher = nullptr;
+}
+
+void NotificationDispatcher::add_subscriber(const std::string& identifier,
+                                            std::shared_ptr<ClientSessionInterface> session)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  outboxes_[identifier].session = std::move(session);
+}
+
+void NotificationDispatcher::remove_subscriber(const std::string& identifier)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  outboxes_.erase(identifier);
+}
+
+void NotificationDispatcher::close_subscriber(const std::string& identifier,
+                                              std::shared_ptr<ClientSessionInterface> session,
+                                              std::shared_ptr<const std::string> message)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& outbox = outboxes_[identifier];
+    if (session != nullptr)
+    {
+      outbox.session = std::move(session);
+    }
+    outbox.closing = true;
+    outbox.pending.clear();
+    outbox.pending.emplace_back(
+        std::make_shared<const Notification>(Notification{std::move(message), {}, {}}));
+    schedule(identifier, outbox);
+  }
+  ready_condition_.notify_one();
+}
+
+bool NotificationDispatcher::enqueue(const std::string& identifier,
+                                     std::shared_ptr<const Notification> notification)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto outbox = outboxes_.find(identifier);
+    if (outbox == outboxes_.end() || outbox->second.closing)
+    {
+      // the subscription ended after the notification was routed to it
+      LOG(LogLevel::DEBUG, "Discarding notification of ended subscription " << identifier);
+      return true;
+    }
+    auto& pending = outbox->second.pending;
+    if (policy_ == OverflowPolicy::COALESCE)
+    {
+      coalesce(outbox->second, *notification);
+    }
+    if (pending.size() >= max_pending_)
+    {
+      if (policy_ == OverflowPolicy::END_SUBSCRIPTION)
+      {
+        LOG(LogLevel::WARNING, "Outbox of " << identifier << " full. Rejecting notification");
+        ++statistics_.rejected;
+        return false;
+      }
+      LOG(LogLevel::WARNING, "Outbox of " << identifier << " full. Dropping oldest notification");
+      pending.pop_front();
+      ++statistics_.dropped;
+    }
+    pending.emplace_back(std::move(notification));
+    if (outbox->second.scheduled)
+    {
+      return true;
+    }
+    schedule(identifier, outbox->second);
+  }
+  ready_condition_.notify_one();
+  return true;
+}
+
+NotificationDispatcher::Statistics NotificationDispatcher::get_statistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+void NotificationDispatcher::coalesce(Outbox& outbox, const Notification& notification)
+{
+  if (notification.handles.empty())
+  {
+    return;
+  }
+  const auto superseded = [&notification](const auto& pending) {
+    return pending->action == notification.action && !pending->handles.empty() &&
+           std::includes(notification.handles.begin(), notification.handles.end(),
+                         pending->handles.begin(), pending->handles.end());
+  };
+  const auto new_end = std::remove_if(outbox.pending.begin(), outbox.pending.end(), superseded);
+  statistics_.coalesced += static_cast<std::size_t>(std::distance(new_end, outbox.pending.end()));
+  outbox.pending.erase(new_end, outbox.pending.end());
+}
+
+void NotificationDispatcher::schedule(const std::string& identifier, Outbox& outbox)
+{
+  if (outbox.scheduled)
+  {
+    return;
+  }
+  outbox.scheduled = true;
+  ready_.emplace_back(identifier);
+}
+
+void NotificationDispatcher::settle(std::map<std::string, Outbox>::iterator outbox)
+{
+  auto& box = outbox->second;
+  if (!box.pending.empty() && box.in_flight < max_in_flight_)
+  {
+    // requeue at the back to serve all subscribers in turn
+    ready_.emplace_back(outbox->first);
+    ready_condition_.notify_one();
+  }
+  else if (box.pending.empty() && box.in_flight == 0 && box.closing)
+  {
+    outboxes_.erase(outbox);
+  }
+  else
+  {
+    // a full window is rescheduled by the completion of a message in flight
+    box.scheduled = false;
+  }
+}
+
+void NotificationDispatcher::on_delivered(const std::string& identifier, const bool delivered)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  --in_flight_;
+  if (!delivered)
+  {
+    ++statistics_.failed;
+  }
+  auto outbox = outboxes_.find(identifier);
+  if (outbox != outboxes_.end())
+  {
+    --outbox->second.in_flight;
+    if (!outbox->second.scheduled)
+    {
+      outbox->second.scheduled = true;
+      settle(outbox);
+    }
+  }
+  if (in_flight_ == 0)
+  {
+    idle_condition_.notify_all();
+  }
+}
+
+void NotificationDispatcher::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::vector<std::shared_ptr<const Notification>> batch;
+  while (true)
+  {
+    ready_condition_.wait(lock, [this]() { return stopping_ || !ready_.empty(); });
+    if (stopping_)
+    {
+      return;
+    }
+    const auto identifier = std::move(ready_.front());
+    ready_.pop_front();
+    auto outbox = outboxes_.find(identifier);
+    if (outbox == outboxes_.end())
+    {
+      continue;
+    }
+    auto& box = outbox->second;
+    while (!box.pending.empty() && box.in_flight < max_in_flight_)
+    {
+      batch.emplace_back(std::move(box.pending.front()));
+      box.pending.pop_front();
+      ++box.in_flight;
+      ++in_flight_;
+    }
+    if (batch.empty())
+    {
+      settle(outbox);
+      continue;
+    }
+    const auto session = box.session;
+
+    // this outbox stays scheduled while sending, so its messages are handed over in order
+    lock.unlock();
+    for (const auto& notification : batch)
+    {
+      session->send_async(notification->message, [target = completion_target_,
+                                                   identifier](const bool delivered) {
+        std::lock_guard<std::mutex> target_lock(target->mutex);
+        if (target->dispatcher != nullptr)
+        {
+          target->dispatcher->on_delivered(identifier, delivered);
+        }
+      });
+    }
+    batch.clear();
+    lock.lock();
+
+    // the outbox might have been removed while sending
+    outbox = outboxes_.find(identifier);
+    if (outbox != outboxes_.end())
+    {
+      settle(outbox);
+    }
+  }
+}
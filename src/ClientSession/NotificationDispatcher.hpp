@@ -0,0 +1,185 @@
+#pragma once
+
+#include "ClientSession.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief NotificationDispatcher decouples the producers of notifications from their delivery.
+/// Each subscriber owns a bounded outbox which is drained by a pool of dispatcher threads. A
+/// subscriber is handled by at most one dispatcher thread at a time, which hands up to
+/// max_in_flight messages to the asynchronous client session. So messages are delivered in the
+/// order they were queued and a slow subscriber only delays its own notifications.
+class NotificationDispatcher
+{
+public:
+  /// @brief OverflowPolicy defines how an outbox behaves when its subscriber cannot keep up
+  enum class OverflowPolicy
+  {
+    /// discard the oldest pending notification when the outbox is full
+    DROP_OLDEST,
+    /// replace pending notifications whose descriptor handles are all reported again by a newer
+    /// notification of the same action. Falls back to DROP_OLDEST when the outbox is still full
+    COALESCE,
+    /// reject the notification when the outbox is full so the subscription can be ended
+    END_SUBSCRIPTION
+  };
+
+  /// @brief Notification is a serialized message together with the information needed to
+  /// coalesce it with other notifications
+  struct Notification
+  {
+    /// the serialized message
+    std::shared_ptr<const std::string> message;
+    /// the action of the message
+    std::string action;
+    /// sorted descriptor handles of the states reported by this message
+    std::vector<std::string> handles;
+  };
+
+  /// @brief Statistics counts notifications that were not delivered as queued
+  struct Statistics
+  {
+    /// notifications discarded because an outbox was full
+    std::size_t dropped{0};
+    /// notifications replaced by a newer notification for the same descriptor handles
+    std::size_t coalesced{0};
+    /// notifications rejected because an outbox was full under END_SUBSCRIPTION
+    std::size_t rejected{0};
+    /// notifications the client session failed to deliver
+    std::size_t failed{0};
+  };
+
+  /// @brief constructs a new NotificationDispatcher and starts its dispatcher threads
+  /// @param num_threads the number of dispatcher threads delivering messages
+  /// @param max_pending the maximum number of queued messages per subscriber, at least 1
+  /// @param policy the policy applied to outboxes of subscribers not keeping up
+  /// @param max_in_flight the maximum number of messages per subscriber awaiting their delivery
+  /// @param drain_timeout the time the destructor waits for messages in flight to complete
+  NotificationDispatcher(std::size_t num_threads, std::size_t max_pending, OverflowPolicy policy,
+                         std::size_t max_in_flight, std::chrono::milliseconds drain_timeout);
+  NotificationDispatcher(const NotificationDispatcher&) = delete;
+  NotificationDispatcher(NotificationDispatcher&&) = delete;
+  NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+  NotificationDispatcher& operator=(NotificationDispatcher&&) = delete;
+  /// @brief stops the dispatcher threads and waits up to the drain timeout for the messages in
+  /// flight to complete. Completions arriving later are discarded.
+  ~NotificationDispatcher();
+
+  /// @brief creates an outbox for a subscriber
+  /// @param identifier the identifier of the subscription
+  /// @param session the client session to deliver the messages of this subscriber with
+  void add_subscriber(const std::string& identifier,
+                      std::shared_ptr<ClientSessionInterface> session);
+
+  /// @brief removes the outbox of a subscriber and discards all of its pending messages
+  /// @param identifier the identifier of the subscription
+  void remove_subscriber(const std::string& identifier);
+
+  /// @brief discards all pending messages of a subscriber and removes its outbox after a final
+  /// message was delivered
+  /// @param identifier the identifier of the subscription
+  /// @param session the client session to deliver the final message with or nullptr to deliver it
+  /// after the messages in flight with the session of the subscriber
+  /// @param message the final message
+  void close_subscriber(const std::string& identifier,
+                        std::shared_ptr<ClientSessionInterface> session,
+                        std::shared_ptr<const std::string> message);
+
+  /// @brief queues a notification for delivery to a subscriber. This never waits on the network.
+  /// A full outbox is handled according to the configured OverflowPolicy.
+  /// @param identifier the identifier of the subscription
+  /// @param notification the notification to deliver
+  /// @return false if the notification was rejected because the outbox is full and the policy is
+  /// END_SUBSCRIPTION, true otherwise
+  bool enqueue(const std::string& identifier, std::shared_ptr<const Notification> notification);
+
+  /// @brief gets the accumulated counters of all outboxes
+  /// @return the statistics of this dispatcher
+  Statistics get_statistics() const;
+
+private:
+  /// @brief Outbox holds the pending messages of one subscriber
+  struct Outbox
+  {
+    /// the session to deliver the messages with
+    std::shared_ptr<ClientSessionInterface> session;
+    /// notifications waiting for delivery in order
+    std::deque<std::shared_ptr<const Notification>> pending;
+    /// number of notifications handed to the session and awaiting their delivery
+    std::size_t in_flight{0};
+    /// whether this outbox is queued in ready_ or currently served by a dispatcher thread
+    bool scheduled{false};
+    /// whether this outbox is removed once all pending and in flight messages are delivered
+    bool closing{false};
+  };
+
+  /// maximum number of pending messages per outbox
+  const std::size_t max_pending_;
+  /// the policy applied to full outboxes
+  const OverflowPolicy policy_;
+  /// maximum number of messages in flight per outbox
+  const std::size_t max_in_flight_;
+  /// time the destructor waits for messages in flight
+  const std::chrono::milliseconds drain_timeout_;
+
+  /// @brief CompletionTarget forwards completions of messages in flight to their dispatcher,
+  /// which detaches itself on destruction so that late completions are discarded
+  struct CompletionTarget
+  {
+    /// mutex serializing completions with the detachment of the dispatcher
+    std::mutex mutex;
+    /// the dispatcher to forward completions to, nullptr once it is destroyed
+    NotificationDispatcher* dispatcher;
+  };
+  /// the completion target referenced by all completions handed to client sessions
+  const std::shared_ptr<CompletionTarget> completion_target_;
+  /// mutex protecting the outboxes, the ready queue and the statistics
+  mutable std::mutex mutex_;
+  /// signals dispatcher threads about ready outboxes or shutdown
+  std::condition_variable ready_condition_;
+  /// outboxes of all subscribers, identifier->outbox
+  std::map<std::string, Outbox> outboxes_;
+  /// identifiers of outboxes with pending messages waiting for a dispatcher thread. Each outbox is
+  /// contained at most once, so this queue is bounded by the number of subscribers
+  std::deque<std::string> ready_;
+  /// accumulated counters of all outboxes
+  Statistics statistics_;
+  /// number of messages in flight over all outboxes
+  std::size_t in_flight_{0};
+  /// signals the destructor that no message is in flight anymore
+  std::condition_variable idle_condition_;
+  /// whether the dispatcher threads should terminate
+  bool stopping_{false};
+  /// the dispatcher threads
+  std::vector<std::thread> threads_;
+
+  /// @brief removes pending notifications which are superseded by a newer notification
+  /// @param outbox the outbox to coalesce
+  /// @param notification the newer notification
+  void coalesce(Outbox& outbox, const Notification& notification);
+
+  /// @brief queues an outbox for a dispatcher thread if it is not already scheduled
+  /// @param identifier the identifier of the outbox
+  /// @param outbox the outbox to schedule
+  void schedule(const std::string& identifier, Outbox& outbox);
+
+  /// @brief queues an outbox no dispatcher thread is serving if it can send more messages, or
+  /// removes it if it is closing and done
+  /// @param outbox the outbox to settle
+  void settle(std::map<std::string, Outbox>::iterator outbox);
+
+  /// @brief completes a message handed to a client session
+  /// @param identifier the identifier of the outbox the message was taken from
+  /// @param delivered whether the message was delivered
+  void on_delivered(const std::string& identifier, bool delivered);
+
+  /// @brief main loop of a dispatcher thread, sending the messages of one ready outbox at a time
+  void run();
+};
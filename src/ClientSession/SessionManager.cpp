@@ -1,34 +1,69 @@
 #include "SessionManager.hpp"
 #include "Log.hpp"
+#include <algorithm>
 
-SessionManager::SessionManager(const bool use_tls)
+static constexpr const char* TAG = "SessionManager";
+
+SessionManager::SessionManager(const bool use_tls, ClientSessionConfig config)
   : use_tls_(use_tls)
+  , config_(std::move(config))
 {
 }
 
-void SessionManager::create_session(const std::string& notify_to)
+std::shared_ptr<ClientSessionInterface> SessionManager::get_session(const std::string& address)
 {
-  if (sessions_.count(notify_to) != 0)
-  {
-    LOG(LogLevel::INFO, "Client session already exists");
-    return;
-  }
-  sessions_.emplace(notify_to, ClientSessionFactory::produce(notify_to, use_tls_));
+  return get_session(address, use_tls_);
 }
 
-void SessionManager::send_to_session(const std::string& notify_to, const std::string& message)
+std::shared_ptr<ClientSessionInterface> SessionManager::get_session(const std::string& address,
+                                                                    const bool use_tls)
 {
-  const auto session_it = sessions_.find(notify_to);
-  if (session_it == sessions_.end())
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& sessions = pools_[{address, use_tls}].sessions;
+  // forget the sessions of this address which are not used anymore
+  sessions.erase(std::remove_if(sessions.begin(), sessions.end(),
+                                [](const auto& session) { return session.expired(); }),
+                 sessions.end());
+
+  // reuse the least loaded session, unless it is busy and another connection may be opened
+  std::shared_ptr<ClientSessionInterface> least_loaded;
+  std::size_t least_pending = 0;
+  for (const auto& weak_session : sessions)
   {
-    LOG(LogLevel::ERROR, "Cannot find client session with address " << notify_to);
-    return;
+    auto session = weak_session.lock();
+    if (session == nullptr)
+    {
+      continue;
+    }
+    const auto pending = session->pending();
+    if (least_loaded == nullptr || pending < least_pending)
+    {
+      least_loaded = std::move(session);
+      least_pending = pending;
+    }
+    if (least_pending == 0)
+    {
+      break;
+    }
   }
-  LOG(LogLevel::INFO, "Sending to " << notify_to);
-  session_it->second->send(message);
+  if (least_loaded != nullptr &&
+      (least_pending == 0 ||
+       sessions.size() >= std::max<std::size_t>(config_.max_connections_per_host, 1)))
+  {
+    return least_loaded;
+  }
+  LOG(LogLevel::INFO, "Opening client session " << sessions.size() + 1 << " to " << address);
+  auto session = ClientSessionFactory::produce(address, use_tls, config_);
+  sessions.emplace_back(session);
+  return session;
+}
+
+const ClientSessionConfig& SessionManager::get_config() const
+{
+  return config_;
 }
 
-void SessionManager::delete_session(const std::string& notify_to)
+bool SessionManager::is_using_tls() const
 {
-  sessions_.erase(notify_to);
+  return use_tls_;
 }
@@ -3,32 +3,59 @@
 #include "ClientSession.hpp"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
-/// @brief SessionManager defines an interface to client sessions for eventing
-/// notifications
+/// @brief SessionManager pools the client sessions used for eventing notifications and discovery
+/// proxy messages. Sessions are shared by all users of the same address, so their keep-alive
+/// connections are reused, and at most max_connections_per_host sessions are opened per address.
 class SessionManager
 {
 public:
   /// @brief constructs a new SessionManager
   /// @param useTls whether to use TLS for communication
-  explicit SessionManager(bool use_tls);
-  /// @brief creates a new session for a given client address
-  /// @param notifyTo the address of the client
-  void create_session(const std::string& notify_to);
+  /// @param config the connection parameters of the pooled sessions
+  SessionManager(bool use_tls, ClientSessionConfig config);
 
-  /// @brief sends a message string to a client session with given address
-  /// @param notifyTo the address of the client
-  /// @param message the message to send to the client
-  void send_to_session(const std::string& notify_to, const std::string& message);
+  /// @brief gets a session for a given client address. An idle session of the address is reused,
+  /// otherwise a new one is opened until max_connections_per_host sessions are open, after which
+  /// the least loaded one is shared. A session is closed once no user holds it anymore.
+  /// @param address the address of the client
+  /// @return the session of the client
+  std::shared_ptr<ClientSessionInterface> get_session(const std::string& address);
 
-  /// @brief deletes the session of the client with given address
-  /// @param notifyTo the address of the client
-  void delete_session(const std::string& notify_to);
+  /// @brief gets a session for a given client address independent of the TLS setting of this
+  /// manager
+  /// @param address the address of the client
+  /// @param use_tls whether to use TLS for communication
+  /// @return the session of the client
+  std::shared_ptr<ClientSessionInterface> get_session(const std::string& address, bool use_tls);
+
+  /// @brief gets the connection parameters of the pooled sessions
+  /// @return the connection parameters
+  const ClientSessionConfig& get_config() const;
+
+  /// @brief returns whether sessions of this manager use TLS
+  /// @return whether TLS is enabled
+  bool is_using_tls() const;
 
 private:
+  /// @brief Pool holds the sessions opened to one address
+  struct Pool
+  {
+    /// the sessions of this address, expired once no user holds them anymore. They are removed
+    /// when the address is looked up again
+    std::vector<std::weak_ptr<ClientSessionInterface>> sessions;
+  };
+
   /// whether to use TLS encrypted communication
   const bool use_tls_;
-  /// the map of all sessions this manager manages, address->session
-  std::map<std::string, std::shared_ptr<ClientSessionInterface>> sessions_;
+  /// the connection parameters of the pooled sessions
+  const ClientSessionConfig config_;
+  /// mutex protecting pools_
+  std::mutex mutex_;
+  /// the pools of all addresses, (address, use_tls)->pool
+  std::map<std::pair<std::string, bool>, Pool> pools_;
 };
@@ -7,3 +7,5 @@ void Log::set_log_level(const LogLevel level)
 
 // default log level to INFO
 LogLevel Log::log_level__{LogLevel::INFO};
+
+std::mutex Log::mutex__;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <mutex>
 
 /// @brief LogLevel describes the level of severity of a log message
 enum class LogLevel
@@ -64,6 +65,8 @@ private:
 
   /// the lowest log level this logger is writing to the output
   static LogLevel log_level__;
+  /// mutex keeping the lines of concurrently logging threads apart
+  static std::mutex mutex__;
 
 public:
   /// @brief sets the lowest log level this logger is writing to its output
@@ -80,6 +83,7 @@ public:
     {
       return;
     }
+    std::lock_guard<std::mutex> lock(mutex__);
     std::cout << "\x1B[";
     if constexpr (level == LogLevel::ERROR)
     {
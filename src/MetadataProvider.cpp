@@ -1,12 +1,18 @@
 #include "MetadataProvider.hpp"
 #include "SDCConstants.hpp"
 #include "datamodel/MDPWSConstants.hpp"
+#include "datamodel/MessageSerializer.hpp"
 #include "networking/NetworkConfig.hpp"
 
 MetadataProvider::MetadataProvider(std::shared_ptr<const NetworkConfig> network_config,
                                    DeviceCharacteristics dev_char)
   : network_config_(std::move(network_config))
   , device_characteristics_(std::move(dev_char))
+  , device_metadata_(render_metadata(&MetadataProvider::fill_device_metadata))
+  , get_service_metadata_(render_metadata(&MetadataProvider::fill_get_service_metadata))
+  , set_service_metadata_(render_metadata(&MetadataProvider::fill_set_service_metadata))
+  , state_event_service_metadata_(
+        render_metadata(&MetadataProvider::fill_state_event_service_metadata))
 {
 }
 
@@ -83,6 +89,36 @@ void MetadataProvider::fill_state_event_service_metadata(MESSAGEMODEL::Envelope&
       create_host_metadata(), {create_hosted_state_event_service()}));
 }
 
+const std::string& MetadataProvider::rendered_device_metadata() const
+{
+  return device_metadata_;
+}
+
+const std::string& MetadataProvider::rendered_get_service_metadata() const
+{
+  return get_service_metadata_;
+}
+
+const std::string& MetadataProvider::rendered_set_service_metadata() const
+{
+  return set_service_metadata_;
+}
+
+const std::string& MetadataProvider::rendered_state_event_service_metadata() const
+{
+  return state_event_service_metadata_;
+}
+
+std::string MetadataProvider::render_metadata(
+    void (MetadataProvider::*fill)(MESSAGEMODEL::Envelope&) const) const
+{
+  MESSAGEMODEL::Envelope envelope;
+  (this->*fill)(envelope);
+  MessageSerializer serializer;
+  serializer.serialize_elements(envelope.body);
+  return serializer.str();
+}
+
 MetadataProvider::MetadataSection MetadataProvider::create_metadata_section_this_model() const
 {
   MetadataSection metadata = MetadataSection(WS::ADDRESSING::URIType(MDPWS::WS_MEX_DIALECT_MODEL));
@@ -3,6 +3,7 @@
 #include "DeviceCharacteristics.hpp"
 #include "datamodel/MessageModel.hpp"
 #include "datamodel/ws-MetadataExchange.hpp"
+#include <string>
 
 class NetworkConfig;
 
@@ -61,6 +62,22 @@ public:
   /// @param envelope reference to the response envelope to fill
   void fill_state_event_service_metadata(MESSAGEMODEL::Envelope& envelope) const;
 
+  /// @brief gets the serialized body of a GetResponse with the Device Metadata
+  /// @return the body rendered once on construction
+  const std::string& rendered_device_metadata() const;
+
+  /// @brief gets the serialized body of a GetMetadataResponse of the GetService
+  /// @return the body rendered once on construction
+  const std::string& rendered_get_service_metadata() const;
+
+  /// @brief gets the serialized body of a GetMetadataResponse of the SetService
+  /// @return the body rendered once on construction
+  const std::string& rendered_set_service_metadata() const;
+
+  /// @brief gets the serialized body of a GetMetadataResponse of the StateEventService
+  /// @return the body rendered once on construction
+  const std::string& rendered_state_event_service_metadata() const;
+
   /// @brief compile host part of MetadataSection Relationship
   /// @return Host section
   Host create_host_metadata() const;
@@ -109,4 +126,18 @@ private:
   const std::shared_ptr<const NetworkConfig> network_config_;
   /// device characteristics to provide
   const DeviceCharacteristics device_characteristics_;
+  /// serialized Device Metadata. The metadata cannot change during the lifetime of this object,
+  /// so it is rendered only once and not for every request.
+  const std::string device_metadata_;
+  /// serialized GetService Metadata
+  const std::string get_service_metadata_;
+  /// serialized SetService Metadata
+  const std::string set_service_metadata_;
+  /// serialized StateEventService Metadata
+  const std::string state_event_service_metadata_;
+
+  /// @brief serializes the body of an envelope filled with metadata
+  /// @param fill the function filling the metadata into an envelope
+  /// @return the serialized body
+  std::string render_metadata(void (MetadataProvider::*fill)(MESSAGEMODEL::Envelope&) const) const;
 };
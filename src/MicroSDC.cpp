@@ -20,12 +20,14 @@
 #include "wsdl/StateEventServiceWSDL.hpp"
 
 #include "asio/system_error.hpp"
+#include <algorithm>
 
 MicroSDC::MicroSDC()
-  : mdib_(std::make_unique<BICEPS::PM::Mdib>(
-        BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")}))
 {
-  mdib_->md_state = BICEPS::PM::MdState();
+  auto mdib = std::make_shared<BICEPS::PM::Mdib>(
+      BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
+  mdib->md_state = BICEPS::PM::MdState();
+  mdib_ = std::move(mdib);
 }
 
 void MicroSDC::start()
@@ -37,7 +39,7 @@ void MicroSDC::start()
   }
 
   std::lock_guard<std::mutex> lock(running_mutex_);
-  if (running_)
+  if (running_.load())
   {
     LOG(LogLevel::WARNING, "called MicroSDC start but already running!");
     return;
@@ -45,7 +47,7 @@ void MicroSDC::start()
   webserver_ = WebServerFactory::produce(network_config_);
   startup();
   // MicroSDC is now ready und is running
-  running_ = true;
+  running_.store(true);
 }
 
 void MicroSDC::startup()
@@ -70,8 +72,13 @@ void MicroSDC::startup()
 
   initialize_md_states();
 
+  // client sessions are pooled and shared by discovery and eventing
+  session_manager_ =
+      std::make_shared<SessionManager>(network_config_->is_using_tls(), client_session_config_);
+
   discovery_service_ = std::make_unique<DiscoveryService>(
-      WS::ADDRESSING::EndpointReferenceType::AddressType(endpoint_reference_), types, x_addresses);
+      WS::ADDRESSING::EndpointReferenceType::AddressType(endpoint_reference_), types, x_addresses,
+      session_manager_);
   if (location_context_state_ != nullptr && location_context_state_->location_detail.has_value())
   {
     discovery_service_->set_location(location_context_state_->location_detail.value());
@@ -85,7 +92,9 @@ void MicroSDC::startup()
   }
 
   // construct subscription manager
-  subscription_manager_ = std::make_shared<SubscriptionManager>(network_config_->is_using_tls());
+  subscription_manager_ = std::make_shared<SubscriptionManager>(
+      session_manager_, notification_threads_, max_pending_notifications_,
+      notification_overflow_policy_, periodic_report_config_);
 
   // construct web services
   auto device_service = std::make_shared<DeviceService>(metadata);
@@ -109,103 +118,138 @@ void MicroSDC::startup()
   webserver_->add_service(state_event_service);
   webserver_->add_service(state_event_wsdl_service);
 
+  std::atomic_store(&waveform_stream_service_,
+                    std::make_shared<WaveformStreamService>(waveform_stream_config_));
+
   webserver_->start();
   discovery_service_->start();
+  waveform_stream_service_->start();
 }
 
 void MicroSDC::stop()
 {
   std::lock_guard<std::mutex> lock(running_mutex_);
-  if (running_)
+  if (running_.load())
   {
+    running_.store(false);
+    waveform_stream_service_->stop();
     discovery_service_->stop();
     webserver_->stop();
-    running_ = false;
     LOG(LogLevel::INFO, "stopped");
   }
 }
 
 bool MicroSDC::is_running() const
 {
-  std::lock_guard<std::mutex> lock(running_mutex_);
-  return running_;
+  return running_.load();
 }
 
 void MicroSDC::initialize_md_states()
 {
   std::lock_guard<std::mutex> lock(mdib_mutex_);
+  auto mdib = std::make_shared<BICEPS::PM::Mdib>(*std::atomic_load(&mdib_));
+  operation_target_index_.clear();
+  auto sample_array_handles = std::make_shared<std::unordered_set<std::string>>();
   for (const auto& handler : state_handlers_)
   {
-    mdib_->md_state->state.emplace_back(handler->get_initial_state());
+    insert_md_state(*mdib, handler->get_initial_state());
   }
-  for (const auto& md : mdib_->md_description->mds)
+  for (const auto& md : mdib->md_description->mds)
   {
-    mdib_->md_state->state.emplace_back(std::make_shared<BICEPS::PM::MdsState>(md.handle));
+    insert_md_state(*mdib, std::make_shared<BICEPS::PM::MdsState>(md.handle));
     if (md.system_context.has_value())
     {
-      mdib_->md_state->state.emplace_back(
-          std::make_shared<BICEPS::PM::SystemContextState>(md.system_context.value().handle));
+      insert_md_state(*mdib, std::make_shared<BICEPS::PM::SystemContextState>(
+                                 md.system_context.value().handle));
     }
     for (const auto& vmd : md.vmd)
     {
-      mdib_->md_state->state.emplace_back(std::make_shared<BICEPS::PM::VmdState>(vmd.handle));
+      insert_md_state(*mdib, std::make_shared<BICEPS::PM::VmdState>(vmd.handle));
       for (const auto& channel : vmd.channel)
       {
-        mdib_->md_state->state.emplace_back(
-            std::make_shared<BICEPS::PM::ChannelState>(channel.handle));
+        insert_md_state(*mdib, std::make_shared<BICEPS::PM::ChannelState>(channel.handle));
+        for (const auto& metric : channel.metric)
+        {
+          if (isa<BICEPS::PM::RealTimeSampleArrayMetricDescriptor>(*metric))
+          {
+            sample_array_handles->emplace(metric->handle);
+          }
+        }
       }
       if (!vmd.sco.has_value())
       {
         continue;
       }
-      mdib_->md_state->state.emplace_back(
-          std::make_shared<BICEPS::PM::ScoState>(vmd.sco.value().handle));
+      insert_md_state(*mdib, std::make_shared<BICEPS::PM::ScoState>(vmd.sco.value().handle));
       for (const auto& operation : vmd.sco.value().operation)
       {
+        operation_target_index_.emplace(operation->handle, operation->operation_target);
         if (const auto descriptor = dyn_cast<BICEPS::PM::SetValueOperationDescriptor>(operation);
             descriptor != nullptr)
         {
-          mdib_->md_state->state.emplace_back(std::make_shared<BICEPS::PM::SetValueOperationState>(
-              descriptor->handle, BICEPS::PM::OperatingMode::NA));
+          insert_md_state(*mdib, std::make_shared<BICEPS::PM::SetValueOperationState>(
+                                     descriptor->handle, BICEPS::PM::OperatingMode::NA));
         }
         else if (const auto descriptor =
                      dyn_cast<BICEPS::PM::SetStringOperationDescriptor>(operation);
                  descriptor != nullptr)
         {
-          mdib_->md_state->state.emplace_back(std::make_shared<BICEPS::PM::SetStringOperationState>(
-              descriptor->handle, BICEPS::PM::OperatingMode::NA));
+          insert_md_state(*mdib, std::make_shared<BICEPS::PM::SetStringOperationState>(
+                                     descriptor->handle, BICEPS::PM::OperatingMode::NA));
         }
       }
     }
   }
+  std::atomic_store(&sample_array_handles_,
+                    std::shared_ptr<const std::unordered_set<std::string>>(
+                        std::move(sample_array_handles)));
+  publish_mdib(std::move(mdib));
+}
+
+void MicroSDC::insert_md_state(BICEPS::PM::Mdib& mdib,
+                               std::shared_ptr<BICEPS::PM::AbstractState> state)
+{
+  auto& states = mdib.md_state->state;
+  const auto [slot, inserted] = state_index_.try_emplace(state->descriptor_handle, states.size());
+  if (inserted)
+  {
+    states.push_back(std::move(state));
+  }
+  else
+  {
+    states.set(slot->second, std::move(state));
+  }
 }
 
 void MicroSDC::set_location(const std::string& descriptor_handle, const std::string& state_handle,
                             const BICEPS::PM::LocationDetail& location_detail)
 {
-  auto mdib_version = get_mdib_version();
   std::lock_guard<std::mutex> lock(mdib_mutex_);
-  if (location_context_state_ == nullptr)
-  {
-    location_context_state_ =
-        std::make_shared<BICEPS::PM::LocationContextState>(descriptor_handle, state_handle);
-    mdib_->md_state->state.emplace_back(location_context_state_);
-  }
-  location_context_state_->location_detail = location_detail;
+  auto mdib = std::make_shared<BICEPS::PM::Mdib>(*std::atomic_load(&mdib_));
+  // published states are immutable, so the location context state is changed on a copy
+  auto location_context_state =
+      location_context_state_ == nullptr
+          ? std::make_shared<BICEPS::PM::LocationContextState>(descriptor_handle, state_handle)
+          : std::make_shared<BICEPS::PM::LocationContextState>(*location_context_state_);
+  location_context_state->location_detail = location_detail;
 
   BICEPS::PM::InstanceIdentifier identification;
   identification.root = WS::ADDRESSING::URIType("sdc.ctxt.loc.detail");
   identification.extension = location_detail.facility.value() + "///" +
                              location_detail.poc.value() + "//" + location_detail.bed.value();
-  location_context_state_->identification.emplace_back(identification);
+  location_context_state->identification.emplace_back(identification);
 
   BICEPS::PM::InstanceIdentifier validator;
   identification.root = WS::ADDRESSING::URIType("Validator");
   identification.extension = "System";
-  location_context_state_->validator.emplace_back(validator);
+  location_context_state->validator.emplace_back(validator);
 
-  location_context_state_->context_association = BICEPS::PM::ContextAssociation::ASSOC;
-  location_context_state_->binding_mdib_version = mdib_version;
+  location_context_state->context_association = BICEPS::PM::ContextAssociation::ASSOC;
+  location_context_state->binding_mdib_version = get_mdib_version();
+
+  insert_md_state(*mdib, location_context_state);
+  location_context_state_ = location_context_state;
+  publish_mdib(std::move(mdib));
 
   if (discovery_service_ != nullptr && location_context_state_->location_detail.has_value())
   {
@@ -221,39 +265,42 @@ BICEPS::MM::InvocationState MicroSDC::request_state_change(const BICEPS::MM::Abs
     LOG(LogLevel::ERROR, "No operation target for " << set.operation_handle_ref << " found!");
     return BICEPS::MM::InvocationState::FAIL;
   }
-  const auto handler =
-      std::find_if(state_handlers_.begin(), state_handlers_.end(), [&](const auto& handler) {
-        return handler->get_descriptor_handle() == target_handle.value();
-      });
-  if (handler == state_handlers_.end())
+  const auto handler = state_handler_index_.find(target_handle.value());
+  if (handler == state_handler_index_.end())
   {
     LOG(LogLevel::ERROR, "No state handler for " << target_handle.value() << " found!");
     return BICEPS::MM::InvocationState::FAIL;
   }
-  return (*handler)->request_state_change(set);
+  return handler->second->request_state_change(set);
 }
 
-const BICEPS::PM::Mdib& MicroSDC::get_mdib() const
+std::shared_ptr<const BICEPS::PM::Mdib> MicroSDC::get_mdib() const
 {
-  std::lock_guard<std::mutex> lock(mdib_mutex_);
-  return *mdib_;
+  return std::atomic_load(&mdib_);
+}
+
+void MicroSDC::publish_mdib(std::shared_ptr<const BICEPS::PM::Mdib> mdib)
+{
+  std::atomic_store(&mdib_, std::move(mdib));
 }
 
 void MicroSDC::set_md_description(const BICEPS::PM::MdDescription& md_description)
 {
   std::lock_guard<std::mutex> running_lock(running_mutex_);
-  if (running_)
+  if (running_.load())
   {
     throw std::runtime_error("MicroSDC has to be stopped to set MdDescription!");
   }
   std::lock_guard<std::mutex> lock(mdib_mutex_);
-  mdib_->md_description = md_description;
+  auto mdib = std::make_shared<BICEPS::PM::Mdib>(*std::atomic_load(&mdib_));
+  mdib->md_description = std::make_shared<const BICEPS::PM::MdDescription>(md_description);
+  publish_mdib(std::move(mdib));
 }
 
 void MicroSDC::set_device_characteristics(DeviceCharacteristics dev_char)
 {
   std::lock_guard<std::mutex> lock(running_mutex_);
-  if (running_)
+  if (running_.load())
   {
     throw std::runtime_error("MicroSDC has to be stopped to set DeviceCharacteristics!");
   }
@@ -277,13 +324,75 @@ std::string MicroSDC::get_endpoint_reference() const
 void MicroSDC::set_network_config(std::unique_ptr<NetworkConfig> network_config)
 {
   std::lock_guard<std::mutex> lock(running_mutex_);
-  if (running_)
+  if (running_.load())
   {
     throw std::runtime_error("MicroSDC has to be stopped to set NetworkConfig!");
   }
   network_config_ = std::move(network_config);
 }
 
+void MicroSDC::set_notification_queue_policy(const std::size_t max_pending,
+                                             const NotificationDispatcher::OverflowPolicy policy)
+{
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (running_.load())
+  {
+    throw std::runtime_error("MicroSDC has to be stopped to set the notification queue policy!");
+  }
+  max_pending_notifications_ = std::max<std::size_t>(max_pending, 1);
+  notification_overflow_policy_ = policy;
+}
+
+void MicroSDC::set_notification_threads(const std::size_t num_threads)
+{
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (running_.load())
+  {
+    throw std::runtime_error("MicroSDC has to be stopped to set the notification threads!");
+  }
+  notification_threads_ = std::max<std::size_t>(num_threads, 1);
+}
+
+void MicroSDC::set_client_session_config(const ClientSessionConfig& config)
+{
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (running_.load())
+  {
+    throw std::runtime_error("MicroSDC has to be stopped to set the client session config!");
+  }
+  client_session_config_ = config;
+}
+
+void MicroSDC::set_periodic_report_config(const PeriodicReportConfig& config)
+{
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (running_.load())
+  {
+    throw std::runtime_error("MicroSDC has to be stopped to set the periodic report config!");
+  }
+  periodic_report_config_ = config;
+}
+
+void MicroSDC::set_waveform_stream_config(const WaveformStreamConfig& config)
+{
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (running_.load())
+  {
+    throw std::runtime_error("MicroSDC has to be stopped to set the waveform stream config!");
+  }
+  waveform_stream_config_ = config;
+}
+
+NotificationDispatcher::Statistics MicroSDC::get_notification_statistics() const
+{
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (subscription_manager_ == nullptr)
+  {
+    return {};
+  }
+  return subscription_manager_->get_notification_statistics();
+}
+
 std::string MicroSDC::calculate_uuid()
 {
   auto uuid = UUIDGenerator{}();
@@ -298,82 +407,197 @@ std::string MicroSDC::calculate_message_id()
 void MicroSDC::add_md_state(std::shared_ptr<StateHandler> state_handler)
 {
   state_handler->set_micro_sdc(this);
+  state_handler_index_[state_handler->get_descriptor_handle()] = state_handler;
   state_handlers_.emplace_back(std::move(state_handler));
 }
 
+void MicroSDC::stream_samples(const std::string& descriptor_handle,
+                              const BICEPS::PM::SampleArrayValue::SamplesType& samples)
+{
+  if (!running_.load() || samples.empty())
+  {
+    return;
+  }
+  // snapshots, as a concurrent restart replaces both
+  const auto sample_array_handles = std::atomic_load(&sample_array_handles_);
+  const auto waveform_stream_service = std::atomic_load(&waveform_stream_service_);
+  if (sample_array_handles->count(descriptor_handle) == 0)
+  {
+    throw std::runtime_error("Cannot find RealTimeSampleArrayMetricDescriptor with handle '" +
+                             descriptor_handle + "' in mdib");
+  }
+  waveform_stream_service->push_samples(descriptor_handle, samples, mdib_version_.load());
+}
+
 void MicroSDC::update_state(const std::shared_ptr<BICEPS::PM::AbstractState>& state)
 {
-  std::lock_guard<std::mutex> lock(running_mutex_);
-  if (!running_)
+  if (!running_.load())
   {
     return;
   }
-  auto new_state = update_mdib(state);
-  if (const auto metric_state = dyn_cast<const BICEPS::PM::AbstractMetricState>(new_state);
+  // locked by update_mdib before the new generation is published, so the reports reach the
+  // subscription manager in the order of their mdib versions
+  std::unique_lock<std::mutex> report_lock(report_mutex_, std::defer_lock);
+  const auto mdib_version = update_mdib(state, report_lock);
+  if (const auto metric_state = dyn_cast<const BICEPS::PM::AbstractMetricState>(state);
       metric_state != nullptr)
   {
-    notify_episodic_metric_report(metric_state);
+    notify_episodic_metric_report({metric_state}, mdib_version);
   }
   else if (const auto component_state =
-               dyn_cast<const BICEPS::PM::AbstractDeviceComponentState>(new_state))
+               dyn_cast<const BICEPS::PM::AbstractDeviceComponentState>(state))
   {
-    notify_episodic_component_report(component_state);
+    notify_episodic_component_report({component_state}, mdib_version);
   }
 }
 
-std::shared_ptr<const BICEPS::PM::AbstractState>
-MicroSDC::update_mdib(const std::shared_ptr<BICEPS::PM::AbstractState>& new_state)
+void MicroSDC::update_states(const std::vector<std::shared_ptr<BICEPS::PM::AbstractState>>& states)
 {
-  increment_mdib_version();
-  std::lock_guard<std::mutex> lock(mdib_mutex_);
-  const auto state = std::find_if(mdib_->md_state->state.begin(), mdib_->md_state->state.end(),
-                                  [new_state](const auto& state) {
-                                    return new_state->descriptor_handle == state->descriptor_handle;
-                                  });
-  if (state == mdib_->md_state->state.end())
+  if (!running_.load() || states.empty())
   {
-    throw std::runtime_error("Cannot find descriptor handle '" + new_state->descriptor_handle +
-                             "'in mdib");
-    return nullptr;
+    return;
+  }
+  // locked by update_mdib before the new generation is published, so the reports reach the
+  // subscription manager in the order of their mdib versions
+  std::unique_lock<std::mutex> report_lock(report_mutex_, std::defer_lock);
+  const auto mdib_version = update_mdib(states, report_lock);
+  BICEPS::MM::MetricReportPart::MetricStateSequence metric_states;
+  BICEPS::MM::ComponentReportPart::ComponentStateSequence component_states;
+  for (const auto& state : states)
+  {
+    if (const auto metric_state = dyn_cast<const BICEPS::PM::AbstractMetricState>(state);
+        metric_state != nullptr)
+    {
+      metric_states.emplace_back(metric_state);
+    }
+    else if (const auto component_state =
+                 dyn_cast<const BICEPS::PM::AbstractDeviceComponentState>(state))
+    {
+      component_states.emplace_back(component_state);
+    }
+  }
+  if (!metric_states.empty())
+  {
+    notify_episodic_metric_report(std::move(metric_states), mdib_version);
+  }
+  if (!component_states.empty())
+  {
+    notify_episodic_component_report(std::move(component_states), mdib_version);
   }
-  new_state->state_version = (*state)->state_version.value_or(0) + 1;
-  *state = new_state;
-  return *state;
 }
 
-void MicroSDC::increment_mdib_version()
+BICEPS::PM::MdibVersionGroup::MdibVersionType
+MicroSDC::update_mdib(const std::shared_ptr<BICEPS::PM::AbstractState>& new_state,
+                      std::unique_lock<std::mutex>& report_lock)
 {
   std::lock_guard<std::mutex> lock(mdib_mutex_);
-  mdib_->mdib_version_group.mdib_version = mdib_->mdib_version_group.mdib_version.value_or(0) + 1;
+  const auto slot = find_state_slot(new_state->descriptor_handle);
+  auto mdib = derive_mdib();
+  replace_md_state(*mdib, slot, new_state);
+  return publish_derived_mdib(std::move(mdib), report_lock);
 }
 
-unsigned int MicroSDC::get_mdib_version() const
+BICEPS::PM::MdibVersionGroup::MdibVersionType
+MicroSDC::update_mdib(const std::vector<std::shared_ptr<BICEPS::PM::AbstractState>>& new_states,
+                      std::unique_lock<std::mutex>& report_lock)
 {
   std::lock_guard<std::mutex> lock(mdib_mutex_);
-  return mdib_->mdib_version_group.mdib_version.value_or(0);
+  std::vector<std::size_t> slots;
+  slots.reserve(new_states.size());
+  for (const auto& new_state : new_states)
+  {
+    slots.emplace_back(find_state_slot(new_state->descriptor_handle));
+  }
+  // a state replaced twice within one generation would be versioned and reported twice
+  auto sorted_slots = slots;
+  std::sort(sorted_slots.begin(), sorted_slots.end());
+  if (const auto duplicate = std::adjacent_find(sorted_slots.begin(), sorted_slots.end());
+      duplicate != sorted_slots.end())
+  {
+    const auto& handle = std::atomic_load(&mdib_)->md_state->state[*duplicate]->descriptor_handle;
+    throw std::runtime_error("Descriptor handle '" + handle + "' is updated twice in one batch");
+  }
+  auto mdib = derive_mdib();
+  for (std::size_t i = 0; i < new_states.size(); ++i)
+  {
+    replace_md_state(*mdib, slots[i], new_states[i]);
+  }
+  return publish_derived_mdib(std::move(mdib), report_lock);
+}
+
+std::size_t MicroSDC::find_state_slot(const std::string& descriptor_handle) const
+{
+  const auto slot = state_index_.find(descriptor_handle);
+  if (slot == state_index_.end())
+  {
+    throw std::runtime_error("Cannot find descriptor handle '" + descriptor_handle + "'in mdib");
+  }
+  return slot->second;
+}
+
+std::shared_ptr<BICEPS::PM::Mdib> MicroSDC::derive_mdib() const
+{
+  // the new generation shares the MdDescription and all state chunks with the current one, only
+  // the chunks holding replaced states are copied
+  auto mdib = std::make_shared<BICEPS::PM::Mdib>(*std::atomic_load(&mdib_));
+  mdib->mdib_version_group.mdib_version = mdib_version_.load() + 1;
+  return mdib;
+}
+
+void MicroSDC::replace_md_state(BICEPS::PM::Mdib& mdib, const std::size_t slot,
+                                const std::shared_ptr<BICEPS::PM::AbstractState>& new_state)
+{
+  auto& states = mdib.md_state->state;
+  // readers may be serializing the published object, and a state still at its slot is assumed
+  // unchanged by the GetMdib cache
+  if (states[slot] == new_state)
+  {
+    throw std::runtime_error("State of descriptor handle '" + new_state->descriptor_handle +
+                             "' is already published, update it with a new object");
+  }
+  new_state->state_version = states[slot]->state_version.value_or(0) + 1;
+  states.set(slot, new_state);
+}
+
+BICEPS::PM::MdibVersionGroup::MdibVersionType
+MicroSDC::publish_derived_mdib(std::shared_ptr<const BICEPS::PM::Mdib> mdib,
+                               std::unique_lock<std::mutex>& report_lock)
+{
+  const auto mdib_version = mdib->mdib_version_group.mdib_version.value();
+  report_lock.lock();
+  publish_mdib(std::move(mdib));
+  mdib_version_.store(mdib_version);
+  return mdib_version;
+}
+
+BICEPS::PM::MdibVersionGroup::MdibVersionType MicroSDC::get_mdib_version() const
+{
+  return mdib_version_.load();
 }
 
 void MicroSDC::notify_episodic_metric_report(
-    std::shared_ptr<const BICEPS::PM::AbstractMetricState> state)
+    BICEPS::MM::MetricReportPart::MetricStateSequence states,
+    BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version)
 {
   BICEPS::MM::MetricReportPart report_part;
-  report_part.metric_state.emplace_back(std::move(state));
+  report_part.metric_state = std::move(states);
   BICEPS::MM::EpisodicMetricReport report(
       BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
   report.report_part.emplace_back(std::move(report_part));
-  report.mdib_version_group.mdib_version = get_mdib_version();
+  report.mdib_version_group.mdib_version = mdib_version;
   subscription_manager_->fire_event(report);
 }
 
 void MicroSDC::notify_episodic_component_report(
-    std::shared_ptr<const BICEPS::PM::AbstractDeviceComponentState> state)
+    BICEPS::MM::ComponentReportPart::ComponentStateSequence states,
+    BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version)
 {
   BICEPS::MM::ComponentReportPart report_part;
-  report_part.component_state.emplace_back(std::move(state));
+  report_part.component_state = std::move(states);
   BICEPS::MM::EpisodicComponentReport report(
       BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
   report.report_part.emplace_back(std::move(report_part));
-  report.mdib_version_group.mdib_version = get_mdib_version();
+  report.mdib_version_group.mdib_version = mdib_version;
   subscription_manager_->fire_event(report);
 }
 
@@ -381,26 +605,11 @@ std::optional<BICEPS::PM::AbstractOperationDescriptor::OperationTargetType>
 MicroSDC::find_operation_target_for_operation_handle(
     const BICEPS::PM::AbstractDescriptor::HandleType& handle) const
 {
-  if (!mdib_->md_description.has_value())
+  std::lock_guard<std::mutex> lock(mdib_mutex_);
+  const auto target = operation_target_index_.find(handle);
+  if (target == operation_target_index_.end())
   {
     return {};
   }
-  for (const auto& md : mdib_->md_description->mds)
-  {
-    for (const auto& vmd : md.vmd)
-    {
-      if (!vmd.sco.has_value())
-      {
-        continue;
-      }
-      for (const auto& operation : vmd.sco->operation)
-      {
-        if (operation->handle == handle)
-        {
-          return operation->operation_target;
-        }
-      }
-    }
-  }
-  return {};
+  return target->second;
 }
@@ -1,16 +1,22 @@
 #pragma once
 
+#include "ClientSession/NotificationDispatcher.hpp"
 #include "DeviceCharacteristics.hpp"
+#include "SubscriptionManager.hpp"
 #include "WebServer/WebServer.hpp"
 #include "discovery/DiscoveryService.hpp"
+#include "streaming/WaveformStreamService.hpp"
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class NetworkConfig;
 class StateHandler;
-class SubscriptionManager;
 namespace BICEPS::PM
 {
   struct LocationContextState;
@@ -37,9 +43,10 @@ public:
   /// @return whether MicroSDC is running
   bool is_running() const;
 
-  /// @brief gets the mdib representation of this MicroSDC instance
-  /// @return constant reference to the mdib
-  const BICEPS::PM::Mdib& get_mdib() const;
+  /// @brief gets the current generation of the mdib representation of this MicroSDC instance.
+  /// The returned snapshot is immutable and stays valid while updates publish newer generations.
+  /// @return pointer to the current mdib snapshot
+  std::shared_ptr<const BICEPS::PM::Mdib> get_mdib() const;
 
   /// @brief updates the MdDescription part of the mdib
   /// @param mdDescription the new mdDescription
@@ -65,6 +72,38 @@ public:
   /// @param networkConfig the pointer to the network configuration
   void set_network_config(std::unique_ptr<NetworkConfig> network_config);
 
+  /// @brief configures how notifications are queued for subscribers which cannot keep up. This
+  /// should be set before start is called!
+  /// @param max_pending the maximum number of notifications queued per subscriber, at least 1
+  /// @param policy the policy applied when the queue of a subscriber is full
+  void set_notification_queue_policy(std::size_t max_pending,
+                                     NotificationDispatcher::OverflowPolicy policy);
+
+  /// @brief sets the number of threads delivering notifications to subscribers. This should be
+  /// set before start is called!
+  /// @param num_threads the number of dispatcher threads, at least one
+  void set_notification_threads(std::size_t num_threads);
+
+  /// @brief configures the pooled connections to subscribers and the discovery proxy. This should
+  /// be set before start is called!
+  /// @param config the connection parameters of the client sessions
+  void set_client_session_config(const ClientSessionConfig& config);
+
+  /// @brief configures the intervals of periodic reports, which aggregate all states changed
+  /// within one period. This should be set before start is called!
+  /// @param config the intervals of the periodic reports
+  void set_periodic_report_config(const PeriodicReportConfig& config);
+
+  /// @brief configures how streamed samples are framed and encoded. This should be set before
+  /// start is called!
+  /// @param config the framing and encoding of the samples
+  void set_waveform_stream_config(const WaveformStreamConfig& config);
+
+  /// @brief gets the counters of notifications that were dropped or coalesced for subscribers
+  /// which did not keep up
+  /// @return the notification statistics
+  NotificationDispatcher::Statistics get_notification_statistics() const;
+
   /// @brief get a valid message id for WS-Addressing
   /// @return string of a message id
   static std::string calculate_message_id();
@@ -77,10 +116,29 @@ public:
   /// @param stateHandler the pointer the stateHandler to add
   void add_md_state(std::shared_ptr<StateHandler> state_handler);
 
-  /// @brief updates a given state in the mdib representation
+  /// @brief updates a given state in the mdib representation. The state object is published as
+  /// part of an immutable mdib generation read concurrently by the services, so it must not be
+  /// modified after it is handed over. Pass a new object for every update.
   /// @param state the state to update
+  /// @throws std::runtime_error if the state object is already published
   void update_state(const std::shared_ptr<BICEPS::PM::AbstractState>& state);
 
+  /// @brief updates several states in the mdib representation as one transaction. All states are
+  /// published with a single mdib version and subscribers receive one episodic report per report
+  /// type containing all changed states. As for update_state, the state objects must not be
+  /// modified after they are handed over.
+  /// @param states the states to update, each descriptor handle may occur only once
+  /// @throws std::runtime_error if a handle occurs twice or a state object is already published
+  void update_states(const std::vector<std::shared_ptr<BICEPS::PM::AbstractState>>& states);
+
+  /// @brief streams samples of a real time sample array metric. The samples are batched into
+  /// frames sent via UDP multicast and bypass the mdib and the subscriptions.
+  /// @param descriptor_handle the handle of the RealTimeSampleArrayMetricDescriptor
+  /// @param samples the new samples in chronological order
+  /// @throws std::runtime_error if the handle is not one of a RealTimeSampleArrayMetricDescriptor
+  void stream_samples(const std::string& descriptor_handle,
+                      const BICEPS::PM::SampleArrayValue::SamplesType& samples);
+
   /// @brief sets the location of this instance
   /// @param descriptorHandle the descriptor of the location state descriptor
   /// @param locationDetail the location information to set
@@ -99,19 +157,41 @@ private:
   std::unique_ptr<DiscoveryService> discovery_service_{nullptr};
   /// pointer to the subscription manager
   std::shared_ptr<SubscriptionManager> subscription_manager_{nullptr};
+  /// pointer to the sender of waveform frames. Replaced on every start, so stream_samples always
+  /// accesses it with std::atomic_load
+  std::shared_ptr<WaveformStreamService> waveform_stream_service_{nullptr};
+  /// pool of client sessions shared by the discovery service and the subscription manager
+  std::shared_ptr<SessionManager> session_manager_{nullptr};
   /// pointer to the WebServer
   std::unique_ptr<WebServerInterface> webserver_{nullptr};
-  /// pointer to the mdib representation
-  std::unique_ptr<BICEPS::PM::Mdib> mdib_{nullptr};
-  /// mutex protecting changes in the mdib
+  /// pointer to the currently published immutable mdib generation. Always accessed with
+  /// std::atomic_load and std::atomic_store
+  std::shared_ptr<const BICEPS::PM::Mdib> mdib_{nullptr};
+  /// mutex serializing writers of the mdib
   mutable std::mutex mdib_mutex_;
+  /// maps descriptor handles to the slot of their state in the mdib's state sequence
+  std::unordered_map<std::string, std::size_t> state_index_;
+  /// handles of all RealTimeSampleArrayMetricDescriptors. Rebuilt on every start and published
+  /// with std::atomic_store, so samples are streamed without locking the mdib
+  std::shared_ptr<const std::unordered_set<std::string>> sample_array_handles_{nullptr};
+  /// maps operation handles to the handle of their operation target
+  std::unordered_map<std::string, BICEPS::PM::AbstractOperationDescriptor::OperationTargetType>
+      operation_target_index_;
   /// all states
   std::vector<std::shared_ptr<StateHandler>> state_handlers_;
+  /// maps descriptor handles to the state handler responsible for it
+  std::unordered_map<std::string, std::shared_ptr<StateHandler>> state_handler_index_;
   /// pointer to the network configuration
   std::shared_ptr<NetworkConfig> network_config_{nullptr};
+  /// mutex held from publishing an mdib generation until its reports are handed to the
+  /// subscription manager. It is locked while holding mdib_mutex_, which orders the reports.
+  std::mutex report_mutex_;
+  /// current mdib version. Only incremented while holding mdib_mutex_ so it always matches the
+  /// most recently published mdib generation
+  std::atomic<BICEPS::PM::MdibVersionGroup::MdibVersionType> mdib_version_{0};
   /// whether SDC is started or stopped
-  bool running_{false};
-  /// mutex protecting running_ member
+  std::atomic_bool running_{false};
+  /// mutex serializing start and stop as well as configuration changes
   mutable std::mutex running_mutex_;
   /// endpoint reference of this MicroSDC instance
   std::string endpoint_reference_;
@@ -122,38 +202,103 @@ private:
 
   /// Device Characteristics of this instance
   DeviceCharacteristics device_characteristics_;
+  /// number of threads delivering notifications to subscribers
+  std::size_t notification_threads_{2};
+  /// maximum number of notifications queued per subscriber
+  std::size_t max_pending_notifications_{64};
+  /// policy applied to subscribers not keeping up with notifications
+  NotificationDispatcher::OverflowPolicy notification_overflow_policy_{
+      NotificationDispatcher::OverflowPolicy::DROP_OLDEST};
+  /// connection parameters of the pooled client sessions
+  ClientSessionConfig client_session_config_;
+  /// intervals of the periodic reports
+  PeriodicReportConfig periodic_report_config_;
+  /// framing and encoding of streamed samples
+  WaveformStreamConfig waveform_stream_config_;
 
 
   /// @brief Starts and initializes all SDC components and services
   void startup();
 
-  /// @brief updates the internal mdib representation with a given state
-  /// @tparam infered state type of the state to update
+  /// @brief updates the internal mdib representation with the given state. The mdib version is
+  /// incremented within the same critical section as the state replacement.
   /// @param state the new state to update in the mdib
-  std::shared_ptr<const BICEPS::PM::AbstractState>
-  update_mdib(const std::shared_ptr<BICEPS::PM::AbstractState>& state);
+  /// @param[out] report_lock unlocked lock of report_mutex_, which is locked before the new
+  /// generation is published
+  /// @return the mdib version of the generation containing the new state
+  BICEPS::PM::MdibVersionGroup::MdibVersionType
+  update_mdib(const std::shared_ptr<BICEPS::PM::AbstractState>& state,
+              std::unique_lock<std::mutex>& report_lock);
+
+  /// @brief updates the internal mdib representation with the given states. The mdib version is
+  /// incremented once within the same critical section as the state replacements. If any
+  /// descriptor handle is unknown or occurs twice, the mdib is left unchanged.
+  /// @param states the new states to update in the mdib
+  /// @param[out] report_lock unlocked lock of report_mutex_, which is locked before the new
+  /// generation is published
+  /// @return the mdib version of the generation containing the new states
+  BICEPS::PM::MdibVersionGroup::MdibVersionType
+  update_mdib(const std::vector<std::shared_ptr<BICEPS::PM::AbstractState>>& states,
+              std::unique_lock<std::mutex>& report_lock);
+
+  /// @brief looks up the slot of a state in the mdib's state sequence. mdib_mutex_ has to be held.
+  /// @param descriptor_handle the descriptor handle of the state
+  /// @return the slot of the state
+  std::size_t find_state_slot(const std::string& descriptor_handle) const;
+
+  /// @brief copies the published mdib generation into a new one with the next mdib version.
+  /// mdib_mutex_ has to be held.
+  /// @return the unpublished new generation
+  std::shared_ptr<BICEPS::PM::Mdib> derive_mdib() const;
 
-  /// @brief update the version attribute of the mdib. Will be called everytime the mdib changes
-  void increment_mdib_version();
+  /// @brief replaces a state of an unpublished generation and increments its state version.
+  /// Rejects the state object currently at the slot, as it is part of a published generation.
+  /// @param mdib the unpublished generation
+  /// @param slot the slot of the state to replace
+  /// @param new_state the new state
+  static void replace_md_state(BICEPS::PM::Mdib& mdib, std::size_t slot,
+                               const std::shared_ptr<BICEPS::PM::AbstractState>& new_state);
+
+  /// @brief publishes a generation created by derive_mdib. mdib_mutex_ has to be held.
+  /// @param mdib the generation to publish
+  /// @param[out] report_lock unlocked lock of report_mutex_, which is locked before publishing
+  /// @return the mdib version of the published generation
+  BICEPS::PM::MdibVersionGroup::MdibVersionType
+  publish_derived_mdib(std::shared_ptr<const BICEPS::PM::Mdib> mdib,
+                       std::unique_lock<std::mutex>& report_lock);
 
   /// @brief returns the current mdib Version
   /// @return the mdib version
-  unsigned int get_mdib_version() const;
+  BICEPS::PM::MdibVersionGroup::MdibVersionType get_mdib_version() const;
 
   /// @brief initializes all registered states by calling there initial state function
   void initialize_md_states();
 
-  /// @brief sends a notification to subscriber about a changed numeric metric state
-  /// @param state a pointer to the state which was updated
-  void notify_episodic_metric_report(std::shared_ptr<const BICEPS::PM::AbstractMetricState> state);
+  /// @brief inserts a state into the mdib and indexes its descriptor handle. A state already
+  /// present for the same descriptor handle is replaced in place. mdib_mutex_ has to be held.
+  /// @param mdib the unpublished mdib generation to insert into
+  /// @param state the state to insert
+  void insert_md_state(BICEPS::PM::Mdib& mdib, std::shared_ptr<BICEPS::PM::AbstractState> state);
+
+  /// @brief atomically replaces the published mdib generation. mdib_mutex_ has to be held.
+  /// @param mdib the new generation to publish
+  void publish_mdib(std::shared_ptr<const BICEPS::PM::Mdib> mdib);
+
+  /// @brief sends a notification to subscriber about changed metric states
+  /// @param states the states which were updated
+  /// @param mdib_version the mdib version the states were published with
+  void notify_episodic_metric_report(BICEPS::MM::MetricReportPart::MetricStateSequence states,
+                                     BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version);
 
-  /// @brief sends a notification to subscriber about a changed device component state
-  /// @param state a pointer to the state which was updated
+  /// @brief sends a notification to subscriber about changed device component states
+  /// @param states the states which were updated
+  /// @param mdib_version the mdib version the states were published with
   void notify_episodic_component_report(
-      std::shared_ptr<const BICEPS::PM::AbstractDeviceComponentState> state);
+      BICEPS::MM::ComponentReportPart::ComponentStateSequence states,
+      BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version);
 
-  /// @brief find_operation_target_for_operation_handle searches all sco to find the operation
-  /// target that was triggered by the handle
+  /// @brief find_operation_target_for_operation_handle looks up the operation target that was
+  /// triggered by the handle
   /// @param handle the handle of the operation to find
   /// @return target of the operation if found
   std::optional<BICEPS::PM::AbstractOperationDescriptor::OperationTargetType>
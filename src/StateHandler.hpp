@@ -33,7 +33,8 @@ public:
   /// @param microSDC the pointer MicroSDC object
   void set_micro_sdc(MicroSDC* micro_sdc);
 
-  /// @brief updates this state in the mdib of the holding MicroSDC object
+  /// @brief updates this state in the mdib of the holding MicroSDC object. The state object is
+  /// published as is and must not be modified afterwards, so construct a new one for every update.
   /// @tparam State infered state type of this state
   /// @param state the new state to update
   void update_state(const std::shared_ptr<BICEPS::PM::AbstractState>& state);
@@ -4,21 +4,44 @@
 #include "MicroSDC.hpp"
 #include "SDCConstants.hpp"
 #include "datamodel/MessageModel.hpp"
+#include "datamodel/MDPWSConstants.hpp"
 #include "datamodel/MessageSerializer.hpp"
 #include "datamodel/ws-addressing.hpp"
 #include "datamodel/xs_duration.hpp"
 #include "uuid/UUIDGenerator.hpp"
 #include <algorithm>
+#include <iterator>
+#include <set>
 
 static constexpr const char* TAG = "SubscriptionManager";
 
-SubscriptionManager::SubscriptionManager(const bool use_tls)
-  : session_manager_(use_tls)
+SubscriptionManager::SubscriptionManager(
+    std::shared_ptr<SessionManager> session_manager, const std::size_t dispatcher_threads,
+    const std::size_t max_pending_notifications,
+    const NotificationDispatcher::OverflowPolicy overflow_policy,
+    const PeriodicReportConfig& periodic_report_config)
+  : session_manager_(std::move(session_manager))
+  , dispatcher_(dispatcher_threads, max_pending_notifications, overflow_policy,
+                session_manager_->get_config().max_requests_in_flight,
+                session_manager_->get_config().request_timeout)
+  , expiry_timer_(timer_context_, std::chrono::steady_clock::now())
+  , periodic_metric_report_(periodic_report_config.metric_interval, timer_context_)
+  , periodic_component_report_(periodic_report_config.component_interval, timer_context_)
 {
+  await_expiry_tick();
+  timer_thread_ = std::thread([this]() { timer_context_.run(); });
+}
+
+SubscriptionManager::~SubscriptionManager()
+{
+  timer_context_.stop();
+  timer_thread_.join();
 }
 
 WS::EVENTING::SubscribeResponse
-SubscriptionManager::dispatch(const WS::EVENTING::Subscribe& subscribe_request)
+SubscriptionManager::dispatch(const WS::EVENTING::Subscribe& subscribe_request,
+                              const std::string& subscription_manager_address,
+                              const BICEPS::PM::MdDescription& md_description)
 {
   if (!subscribe_request.filter.has_value())
   {
@@ -34,30 +57,43 @@ SubscriptionManager::dispatch(const WS::EVENTING::Subscribe& subscribe_request)
       throw std::runtime_error("Unknown event action");
     }
   }
+  std::vector<std::string> handles;
+  if (subscribe_request.handle_filter.has_value())
+  {
+    handles = resolve_handle_filter(subscribe_request.handle_filter.value(), md_description);
+  }
   const auto identifier = "uuid:" + UUIDGenerator{}().to_string();
 
   const Duration duration(subscribe_request.expires.value_or(WS::EVENTING::ExpirationType(
       Duration(Duration::Years{0}, Duration::Months{0}, Duration::Days{0}, Duration::Hours{1},
                Duration::Minutes{0}, Duration::Seconds{0}, false))));
   const auto expires = duration.to_expiration_time_point();
+
+  WS::EVENTING::SubscribeResponse::SubscriptionManagerType subscription_manager{
+      WS::ADDRESSING::URIType(subscription_manager_address)};
+  subscription_manager.reference_parameters =
+      WS::ADDRESSING::ReferenceParametersType(WS::EVENTING::Identifier{identifier});
   SubscriptionInformation info{subscribe_request.delivery.notify_to,
-                               subscribe_request.filter.value(), expires};
+                               subscribe_request.end_to,
+                               subscription_manager,
+                               subscribe_request.filter.value(),
+                               std::move(handles),
+                               expires,
+                               0};
 
   {
     std::lock_guard<std::mutex> lock(subscription_mutex_);
-    subscriptions_.emplace(identifier, info);
+    dispatcher_.add_subscriber(identifier,
+                               session_manager_->get_session(info.notify_to.address));
+    const auto subscription = subscriptions_.emplace(identifier, info).first;
+    add_routes(subscription);
+    schedule_expiry(subscription);
+    LOG(LogLevel::INFO, "Successfully created subscription for " << identifier);
+    print_subscriptions();
   }
-  session_manager_.create_session(info.notify_to.address);
 
-  WS::EVENTING::SubscribeResponse::SubscriptionManagerType subscription_manager(
-      WS::ADDRESSING::EndpointReferenceType(
-          WS::ADDRESSING::URIType("To be filled by Soap Service")));
-  subscription_manager.reference_parameters =
-      WS::ADDRESSING::ReferenceParametersType(WS::EVENTING::Identifier{identifier});
   WS::EVENTING::SubscribeResponse subscribe_response(
       subscription_manager, WS::EVENTING::SubscribeResponse::ExpiresType{duration});
-  LOG(LogLevel::INFO, "Successfully created subscription for " << identifier);
-  print_subscriptions();
   return subscribe_response;
 }
 
@@ -73,7 +109,15 @@ SubscriptionManager::dispatch(const WS::EVENTING::Renew& renew_request,
     throw std::runtime_error("Could not find subscription corresponding to Renew Identifier " +
                              identifier);
   }
-  subscription_info->second.expiration_time = duration.to_expiration_time_point();
+  const auto expiration_time = duration.to_expiration_time_point();
+  const bool expires_earlier = expiration_time < subscription_info->second.expiration_time;
+  subscription_info->second.expiration_time = expiration_time;
+  // an extended subscription stays in its slot of the expiry wheel and is rescheduled when it is
+  // due. A shortened one moves to an earlier slot, leaving a stale entry in its old slot.
+  if (expires_earlier)
+  {
+    schedule_expiry(subscription_info);
+  }
   WS::EVENTING::RenewResponse renew_response;
   renew_response.expires = WS::EVENTING::RenewResponse::ExpiresType{duration};
   LOG(LogLevel::INFO, "Successfully renewed subscription for " << identifier);
@@ -91,93 +135,518 @@ void SubscriptionManager::dispatch(const WS::EVENTING::Unsubscribe& /*unsubscrib
     throw std::runtime_error("Could not find subscription corresponding to Renew Identifier " +
                              identifier);
   }
-  const auto& notify_to = subscription_info->second.notify_to.address;
-  const auto num_same_client =
-      std::count_if(subscriptions_.begin(), subscriptions_.end(), [notify_to](const auto& it) {
-        return it.second.notify_to.address == notify_to;
-      });
-
-  if (num_same_client == 1)
-  {
-    session_manager_.delete_session(notify_to);
-  }
-  subscriptions_.erase(subscription_info);
+  dispatcher_.remove_subscriber(identifier);
+  erase_subscription(subscription_info);
   print_subscriptions();
 }
 
 void SubscriptionManager::fire_event(const BICEPS::MM::EpisodicMetricReport& report)
 {
   LOG(LogLevel::DEBUG, "Fire Event: EpisodicMetricReport");
+  if (periodic_metric_report_.active.load())
+  {
+    std::lock_guard<std::mutex> lock(periodic_report_mutex_);
+    for (const auto& report_part : report.report_part)
+    {
+      for (const auto& state : report_part.metric_state)
+      {
+        periodic_metric_report_.states[state->descriptor_handle] = state;
+      }
+    }
+    periodic_metric_report_.mdib_version = report.mdib_version_group.mdib_version.value_or(0);
+  }
+  notify(SDC::ACTION_EPISODIC_METRIC_REPORT, reported_handles(report),
+         [&report](const std::vector<std::string>& selected) {
+           MESSAGEMODEL::Body body;
+           body.episodic_metric_report = report;
+           retain_states(body.episodic_metric_report.value(), selected);
+           return body;
+         });
+}
+
+void SubscriptionManager::fire_event(const BICEPS::MM::EpisodicComponentReport& report)
+{
+  LOG(LogLevel::DEBUG, "Fire Event: EpisodicComponentReport");
+  if (periodic_component_report_.active.load())
+  {
+    std::lock_guard<std::mutex> lock(periodic_report_mutex_);
+    for (const auto& report_part : report.report_part)
+    {
+      for (const auto& state : report_part.component_state)
+      {
+        periodic_component_report_.states[state->descriptor_handle] = state;
+      }
+    }
+    periodic_component_report_.mdib_version = report.mdib_version_group.mdib_version.value_or(0);
+  }
+  notify(SDC::ACTION_EPISODIC_COMPONENT_REPORT, reported_handles(report),
+         [&report](const std::vector<std::string>& selected) {
+           MESSAGEMODEL::Body body;
+           body.episodic_component_report = report;
+           retain_states(body.episodic_component_report.value(), selected);
+           return body;
+         });
+}
+
+NotificationDispatcher::Statistics SubscriptionManager::get_notification_statistics() const
+{
+  return dispatcher_.get_statistics();
+}
+
+void SubscriptionManager::notify(const std::string& action, std::vector<std::string> handles,
+                                 const BodyFactory& make_body)
+{
+  std::sort(handles.begin(), handles.end());
+  handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+
+  // group the subscribers by the handles they are notified about. Only the routing is done under
+  // the lock, so subscribe, renew and the expiry tick do not wait for the serialization.
+  std::map<std::vector<std::string>, std::vector<std::string>> reports;
+  {
+    std::lock_guard<std::mutex> lock(subscription_mutex_);
+    const auto route = routes_.find(action);
+    if (route == routes_.end())
+    {
+      return;
+    }
+    for (const auto& subscription : route->second)
+    {
+      const auto& filter = subscription->second.handles;
+      if (filter.empty())
+      {
+        reports[handles].emplace_back(subscription->first);
+        continue;
+      }
+      std::vector<std::string> selected;
+      std::set_intersection(handles.begin(), handles.end(), filter.begin(), filter.end(),
+                            std::back_inserter(selected));
+      if (!selected.empty())
+      {
+        reports[std::move(selected)].emplace_back(subscription->first);
+      }
+    }
+  }
+
+  std::vector<std::string> overflowed;
+  for (auto& [selected, subscriber] : reports)
+  {
+    MESSAGEMODEL::Envelope notify_envelope;
+    notify_envelope.header.message_id =
+        MESSAGEMODEL::Header::MessageIDType(MicroSDC::calculate_message_id());
+    notify_envelope.header.action = WS::ADDRESSING::URIType(action);
+    notify_envelope.body = make_body(selected);
+
+    MessageSerializer serializer;
+    serializer.serialize(notify_envelope);
+    // serialized once and shared by the outboxes and connections of all subscribers of this report
+    auto message = std::make_shared<const std::string>(serializer.release());
+    const auto notification = std::make_shared<const NotificationDispatcher::Notification>(
+        NotificationDispatcher::Notification{std::move(message), action, selected});
+    LOG(LogLevel::DEBUG, "SENDING: " << *notification->message);
+    // subscriptions removed in the meantime have no outbox anymore and are skipped by enqueue
+    for (const auto& identifier : subscriber)
+    {
+      if (!dispatcher_.enqueue(identifier, notification))
+      {
+        overflowed.emplace_back(identifier);
+      }
+    }
+  }
+
+  if (overflowed.empty())
+  {
+    return;
+  }
   std::lock_guard<std::mutex> lock(subscription_mutex_);
-  std::vector<const SubscriptionInformation*> subscriber;
-  for (const auto& [id, info] : subscriptions_)
+  for (const auto& identifier : overflowed)
   {
-    if (std::find(info.filter.begin(), info.filter.end(), SDC::ACTION_EPISODIC_METRIC_REPORT) !=
-        info.filter.end())
+    const auto subscription = subscriptions_.find(identifier);
+    if (subscription != subscriptions_.end())
     {
-      subscriber.emplace_back(&info);
+      end_subscription(subscription, MDPWS::WS_EVENTING_STATUS_DELIVERY_FAILURE,
+                       "Subscriber does not keep up with notifications");
     }
   }
-  if (subscriber.empty())
+}
+
+void SubscriptionManager::end_subscription(Subscriptions::iterator subscription,
+                                           const std::string& status, const std::string& reason)
+{
+  const auto& info = subscription->second;
+  LOG(LogLevel::INFO, "Ending subscription " << subscription->first << ": " << reason);
+  if (!info.end_to.has_value())
   {
+    dispatcher_.remove_subscriber(subscription->first);
+    erase_subscription(subscription);
     return;
   }
-  MESSAGEMODEL::Header header;
-  header.message_id = MESSAGEMODEL::Header::MessageIDType(MicroSDC::calculate_message_id());
-  header.action = WS::ADDRESSING::URIType(SDC::ACTION_EPISODIC_METRIC_REPORT);
+  MESSAGEMODEL::Envelope envelope;
+  envelope.header.message_id =
+      MESSAGEMODEL::Header::MessageIDType(MicroSDC::calculate_message_id());
+  envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_SUBSCRIPTION_END);
+  envelope.header.to = info.end_to->address;
+  envelope.body.subscription_end =
+      WS::EVENTING::SubscriptionEnd(info.subscription_manager, status);
+  envelope.body.subscription_end->reason = reason;
 
-  MESSAGEMODEL::Body body;
-  body.episodic_metric_report = report;
+  MessageSerializer serializer;
+  serializer.serialize(envelope);
+  auto session = info.end_to->address == info.notify_to.address
+                     ? nullptr
+                     : session_manager_->get_session(info.end_to->address);
+  dispatcher_.close_subscriber(subscription->first, std::move(session),
+                               std::make_shared<const std::string>(serializer.release()));
+  erase_subscription(subscription);
+}
 
-  MESSAGEMODEL::Envelope notify_envelope;
-  notify_envelope.header = std::move(header);
-  notify_envelope.body = std::move(body);
+void SubscriptionManager::add_routes(const Subscriptions::iterator subscription)
+{
+  for (const auto& action : subscription->second.filter)
+  {
+    auto& route = routes_[action];
+    if (std::find(route.begin(), route.end(), subscription) == route.end())
+    {
+      route.emplace_back(subscription);
+    }
+    if (route.size() == 1)
+    {
+      set_periodic_report_active(action, true);
+    }
+  }
+}
 
-  MessageSerializer serializer;
-  serializer.serialize(notify_envelope);
-  const auto message_str = serializer.str();
-  LOG(LogLevel::DEBUG, "SENDING: " << message_str);
-  for (const auto* const info : subscriber)
+void SubscriptionManager::erase_subscription(const Subscriptions::iterator subscription)
+{
+  for (const auto& action : subscription->second.filter)
   {
-    session_manager_.send_to_session(info->notify_to.address, message_str);
+    const auto route = routes_.find(action);
+    if (route == routes_.end())
+    {
+      continue;
+    }
+    auto& subscriber = route->second;
+    subscriber.erase(std::remove(subscriber.begin(), subscriber.end(), subscription),
+                     subscriber.end());
+    if (subscriber.empty())
+    {
+      routes_.erase(route);
+      set_periodic_report_active(action, false);
+    }
   }
+  subscriptions_.erase(subscription);
 }
 
-void SubscriptionManager::fire_event(const BICEPS::MM::EpisodicComponentReport& report)
+std::vector<std::string>
+SubscriptionManager::reported_handles(const BICEPS::MM::AbstractMetricReport& report)
 {
-  LOG(LogLevel::DEBUG, "Fire Event: EpisodicComponentReport");
-  std::lock_guard<std::mutex> lock(subscription_mutex_);
-  std::vector<const SubscriptionInformation*> subscriber;
-  for (const auto& [id, info] : subscriptions_)
+  std::vector<std::string> handles;
+  for (const auto& report_part : report.report_part)
   {
-    if (std::find(info.filter.begin(), info.filter.end(), SDC::ACTION_EPISODIC_COMPONENT_REPORT) !=
-        info.filter.end())
+    for (const auto& state : report_part.metric_state)
     {
-      subscriber.emplace_back(&info);
+      handles.emplace_back(state->descriptor_handle);
     }
   }
-  if (subscriber.empty())
+  return handles;
+}
+
+std::vector<std::string>
+SubscriptionManager::reported_handles(const BICEPS::MM::AbstractComponentReport& report)
+{
+  std::vector<std::string> handles;
+  for (const auto& report_part : report.report_part)
+  {
+    for (const auto& state : report_part.component_state)
+    {
+      handles.emplace_back(state->descriptor_handle);
+    }
+  }
+  return handles;
+}
+
+void SubscriptionManager::retain_states(BICEPS::MM::AbstractMetricReport& report,
+                                        const std::vector<std::string>& handles)
+{
+  const auto not_selected = [&handles](const auto& state) {
+    return !std::binary_search(handles.begin(), handles.end(), state->descriptor_handle);
+  };
+  for (auto& report_part : report.report_part)
+  {
+    auto& states = report_part.metric_state;
+    states.erase(std::remove_if(states.begin(), states.end(), not_selected), states.end());
+  }
+  report.report_part.erase(
+      std::remove_if(report.report_part.begin(), report.report_part.end(),
+                     [](const auto& report_part) { return report_part.metric_state.empty(); }),
+      report.report_part.end());
+}
+
+void SubscriptionManager::retain_states(BICEPS::MM::AbstractComponentReport& report,
+                                        const std::vector<std::string>& handles)
+{
+  const auto not_selected = [&handles](const auto& state) {
+    return !std::binary_search(handles.begin(), handles.end(), state->descriptor_handle);
+  };
+  for (auto& report_part : report.report_part)
+  {
+    auto& states = report_part.component_state;
+    states.erase(std::remove_if(states.begin(), states.end(), not_selected), states.end());
+  }
+  report.report_part.erase(
+      std::remove_if(report.report_part.begin(), report.report_part.end(),
+                     [](const auto& report_part) { return report_part.component_state.empty(); }),
+      report.report_part.end());
+}
+
+template <typename State>
+void SubscriptionManager::await_period(PeriodicReport<State>& report,
+                                       void (SubscriptionManager::*send_report)())
+{
+  report.timer.expires_at(report.timer.expiry() + report.interval);
+  report.timer.async_wait(
+      [this, &report, send_report, generation = report.generation](const std::error_code& ec) {
+        if (ec || generation != report.generation)
+        {
+          return;
+        }
+        (this->*send_report)();
+        await_period(report, send_report);
+      });
+}
+
+template <typename State>
+void SubscriptionManager::set_periodic_report_active(PeriodicReport<State>& report,
+                                                     const bool active,
+                                                     void (SubscriptionManager::*send_report)())
+{
+  if (report.interval.count() <= 0 || report.active.exchange(active) == active)
   {
     return;
   }
-  MESSAGEMODEL::Header header;
-  header.message_id = MESSAGEMODEL::Header::MessageIDType(MicroSDC::calculate_message_id());
-  header.action = WS::ADDRESSING::URIType(SDC::ACTION_EPISODIC_COMPONENT_REPORT);
+  // the timer is only touched by the timer thread
+  asio::post(timer_context_, [this, &report, active, send_report]() {
+    ++report.generation;
+    report.timer.cancel();
+    {
+      std::lock_guard<std::mutex> lock(periodic_report_mutex_);
+      report.states.clear();
+    }
+    if (active)
+    {
+      report.timer.expires_at(std::chrono::steady_clock::now());
+      await_period(report, send_report);
+    }
+  });
+}
 
-  MESSAGEMODEL::Body body;
-  body.episodic_component_report = report;
+void SubscriptionManager::set_periodic_report_active(const std::string& action, const bool active)
+{
+  if (action == SDC::ACTION_PERIODIC_METRIC_REPORT)
+  {
+    set_periodic_report_active(periodic_metric_report_, active,
+                               &SubscriptionManager::send_periodic_metric_report);
+  }
+  else if (action == SDC::ACTION_PERIODIC_COMPONENT_REPORT)
+  {
+    set_periodic_report_active(periodic_component_report_, active,
+                               &SubscriptionManager::send_periodic_component_report);
+  }
+}
 
-  MESSAGEMODEL::Envelope notify_envelope;
-  notify_envelope.header = std::move(header);
-  notify_envelope.body = std::move(body);
+void SubscriptionManager::send_periodic_metric_report()
+{
+  BICEPS::MM::PeriodicMetricReport report(
+      BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
+  {
+    std::lock_guard<std::mutex> lock(periodic_report_mutex_);
+    if (periodic_metric_report_.states.empty())
+    {
+      return;
+    }
+    BICEPS::MM::MetricReportPart report_part;
+    for (auto& [handle, state] : periodic_metric_report_.states)
+    {
+      report_part.metric_state.emplace_back(std::move(state));
+    }
+    periodic_metric_report_.states.clear();
+    report.report_part.emplace_back(std::move(report_part));
+    report.mdib_version_group.mdib_version = periodic_metric_report_.mdib_version;
+  }
+  notify(SDC::ACTION_PERIODIC_METRIC_REPORT, reported_handles(report),
+         [&report](const std::vector<std::string>& selected) {
+           MESSAGEMODEL::Body body;
+           body.periodic_metric_report = report;
+           retain_states(body.periodic_metric_report.value(), selected);
+           return body;
+         });
+}
 
-  MessageSerializer serializer;
-  serializer.serialize(notify_envelope);
-  const auto message_str = serializer.str();
-  LOG(LogLevel::DEBUG, "SENDING: " << message_str);
-  for (const auto* const info : subscriber)
+void SubscriptionManager::send_periodic_component_report()
+{
+  BICEPS::MM::PeriodicComponentReport report(
+      BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
+  {
+    std::lock_guard<std::mutex> lock(periodic_report_mutex_);
+    if (periodic_component_report_.states.empty())
+    {
+      return;
+    }
+    BICEPS::MM::ComponentReportPart report_part;
+    for (auto& [handle, state] : periodic_component_report_.states)
+    {
+      report_part.component_state.emplace_back(std::move(state));
+    }
+    periodic_component_report_.states.clear();
+    report.report_part.emplace_back(std::move(report_part));
+    report.mdib_version_group.mdib_version = periodic_component_report_.mdib_version;
+  }
+  notify(SDC::ACTION_PERIODIC_COMPONENT_REPORT, reported_handles(report),
+         [&report](const std::vector<std::string>& selected) {
+           MESSAGEMODEL::Body body;
+           body.periodic_component_report = report;
+           retain_states(body.periodic_component_report.value(), selected);
+           return body;
+         });
+}
+
+std::vector<std::string> SubscriptionManager::resolve_handle_filter(
+    const WS::EVENTING::Subscribe::HandleFilterType& handle_filter,
+    const BICEPS::PM::MdDescription& md_description)
+{
+  std::set<std::string> requested(handle_filter.begin(), handle_filter.end());
+  std::vector<std::string> handles;
+  // adds a descriptor if it or one of its ancestors is requested
+  const auto select = [&](const std::string& handle, const bool ancestor_selected) {
+    const bool selected = requested.erase(handle) != 0 || ancestor_selected;
+    if (selected)
+    {
+      handles.emplace_back(handle);
+    }
+    return selected;
+  };
+  const auto select_sco = [&](const auto& component, const bool ancestor_selected) {
+    if (!component.sco.has_value())
+    {
+      return;
+    }
+    const auto sco_selected = select(component.sco->handle, ancestor_selected);
+    for (const auto& operation : component.sco->operation)
+    {
+      select(operation->handle, sco_selected);
+    }
+  };
+  for (const auto& mds : md_description.mds)
+  {
+    const auto mds_selected = select(mds.handle, false);
+    select_sco(mds, mds_selected);
+    if (mds.system_context.has_value())
+    {
+      const auto& system_context = mds.system_context.value();
+      const auto context_selected = select(system_context.handle, mds_selected);
+      if (system_context.patient_context.has_value())
+      {
+        select(system_context.patient_context->handle, context_selected);
+      }
+      if (system_context.location_context.has_value())
+      {
+        select(system_context.location_context->handle, context_selected);
+      }
+    }
+    for (const auto& vmd : mds.vmd)
+    {
+      const auto vmd_selected = select(vmd.handle, mds_selected);
+      select_sco(vmd, vmd_selected);
+      for (const auto& channel : vmd.channel)
+      {
+        const auto channel_selected = select(channel.handle, vmd_selected);
+        for (const auto& metric : channel.metric)
+        {
+          select(metric->handle, channel_selected);
+        }
+      }
+    }
+  }
+  if (!requested.empty())
+  {
+    LOG(LogLevel::ERROR, "Unknown descriptor handle in handle filter: " << *requested.begin());
+    throw std::runtime_error("Unknown descriptor handle");
+  }
+  std::sort(handles.begin(), handles.end());
+  handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+  return handles;
+}
+
+void SubscriptionManager::schedule_expiry(const Subscriptions::iterator subscription)
+{
+  const auto remaining = subscription->second.expiration_time - std::chrono::steady_clock::now();
+  // round up, so the subscription is not due before it expired
+  const auto ticks = std::chrono::ceil<std::chrono::seconds>(remaining) / EXPIRY_TICK;
+  const auto offset =
+      static_cast<std::size_t>(std::clamp<decltype(ticks)>(ticks, 1, EXPIRY_WHEEL_SLOTS - 1));
+  subscription->second.expiry_slot = (expiry_slot_ + offset) % EXPIRY_WHEEL_SLOTS;
+  expiry_wheel_[subscription->second.expiry_slot].emplace_back(subscription->first);
+}
+
+void SubscriptionManager::await_expiry_tick()
+{
+  expiry_timer_.expires_at(expiry_timer_.expiry() + EXPIRY_TICK);
+  expiry_timer_.async_wait([this](const std::error_code& ec) {
+    if (ec)
+    {
+      return;
+    }
+    expire_subscriptions();
+    await_expiry_tick();
+  });
+}
+
+void SubscriptionManager::expire_subscriptions()
+{
+  std::lock_guard<std::mutex> lock(subscription_mutex_);
+  expiry_slot_ = (expiry_slot_ + 1) % EXPIRY_WHEEL_SLOTS;
+  const auto due = std::move(expiry_wheel_[expiry_slot_]);
+  expiry_wheel_[expiry_slot_].clear();
+  if (due.empty())
+  {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  bool expired = false;
+  for (const auto& identifier : due)
+  {
+    const auto subscription = subscriptions_.find(identifier);
+    if (subscription == subscriptions_.end())
+    {
+      // unsubscribed or ended in the meantime
+      continue;
+    }
+    if (subscription->second.expiry_slot != expiry_slot_)
+    {
+      // renewed to expire earlier and therefore moved to another slot
+      continue;
+    }
+    if (subscription->second.expiration_time > now)
+    {
+      // renewed or expiring after the current rotation of the wheel
+      schedule_expiry(subscription);
+      continue;
+    }
+    expired = true;
+    if (END_EXPIRED_SUBSCRIPTIONS)
+    {
+      end_subscription(subscription, MDPWS::WS_EVENTING_STATUS_SOURCE_CANCELLING,
+                       "Subscription expired");
+    }
+    else
+    {
+      LOG(LogLevel::INFO, "Subscription " << identifier << " expired");
+      dispatcher_.remove_subscriber(identifier);
+      erase_subscription(subscription);
+    }
+  }
+  if (expired)
   {
-    session_manager_.send_to_session(info->notify_to.address, message_str);
+    print_subscriptions();
   }
 }
 
@@ -1,34 +1,81 @@
 #pragma once
 
+#include "ClientSession/NotificationDispatcher.hpp"
 #include "ClientSession/SessionManager.hpp"
 #include "SDCConstants.hpp"
 #include "datamodel/ws-addressing.hpp"
 #include "datamodel/ws-eventing.hpp"
+#include <array>
+#include <asio.hpp>
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
-struct esp_http_client;
 namespace BICEPS::MM
 {
   class EpisodicMetricReport;
   class EpisodicComponentReport;
+  struct AbstractMetricReport;
+  struct AbstractComponentReport;
 } // namespace BICEPS::MM
+namespace BICEPS::PM
+{
+  struct MdDescription;
+  struct AbstractMetricState;
+  struct AbstractDeviceComponentState;
+} // namespace BICEPS::PM
+namespace MESSAGEMODEL
+{
+  struct Body;
+} // namespace MESSAGEMODEL
+
+/// @brief PeriodicReportConfig holds the intervals in which the states changed since the last
+/// period are reported to subscribers of periodic reports. A zero interval disables the report.
+/// Reports are only aggregated and sent while they have subscribers.
+struct PeriodicReportConfig
+{
+  /// interval of PeriodicMetricReports
+  std::chrono::milliseconds metric_interval{1000};
+  /// interval of PeriodicComponentReports
+  std::chrono::milliseconds component_interval{5000};
+};
 
 /// @brief SubscriptionManager manages subscriptions in terms of ws-eventing
 class SubscriptionManager
 {
 public:
   /// @brief Constructs a new SubscriptionManager
-  /// @param useTls whether to use TLS encrypted communication
-  explicit SubscriptionManager(bool use_tls);
+  /// @param session_manager the pool of client sessions to deliver notifications with
+  /// @param dispatcher_threads the number of threads delivering notifications
+  /// @param max_pending_notifications the maximum number of notifications queued per subscriber
+  /// @param overflow_policy the policy applied to subscribers not keeping up with notifications
+  /// @param periodic_report_config the intervals of the periodic reports
+  SubscriptionManager(std::shared_ptr<SessionManager> session_manager,
+                      std::size_t dispatcher_threads, std::size_t max_pending_notifications,
+                      NotificationDispatcher::OverflowPolicy overflow_policy,
+                      const PeriodicReportConfig& periodic_report_config);
+  SubscriptionManager(const SubscriptionManager&) = delete;
+  SubscriptionManager(SubscriptionManager&&) = delete;
+  SubscriptionManager& operator=(const SubscriptionManager&) = delete;
+  SubscriptionManager& operator=(SubscriptionManager&&) = delete;
+  ~SubscriptionManager();
+
   /// @brief dispatches a subscribe request, registers the new subscriber and creates a client
   /// session
   /// @param subscribeRequest the request the client send to subscribe
+  /// @param subscription_manager_address the address of the service managing this subscription
+  /// @param md_description the descriptors to resolve the handle filter of the request in
   /// @return the response generated by processing the subscription request
-  WS::EVENTING::SubscribeResponse dispatch(const WS::EVENTING::Subscribe& subscribe_request);
+  WS::EVENTING::SubscribeResponse dispatch(const WS::EVENTING::Subscribe& subscribe_request,
+                                           const std::string& subscription_manager_address,
+                                           const BICEPS::PM::MdDescription& md_description);
 
   /// @brief dispatches a renew request and extends the duration of a subscription
   /// @param renewRequest the request the client send to renew
@@ -44,32 +91,110 @@ public:
   void dispatch(const WS::EVENTING::Unsubscribe& unsubscribe_request,
                 const WS::EVENTING::Identifier& identifier);
 
-  /// @brief triggers an event with given report by notifying all subscribers of this event
+  /// @brief triggers an event with given report by notifying all subscribers of this event. The
+  /// notifications are queued for asynchronous delivery, so this never waits on the network. The
+  /// reported states are aggregated into the next PeriodicMetricReport.
   /// @param report the report to notify about
   void fire_event(const BICEPS::MM::EpisodicMetricReport& report);
 
-  /// @brief triggers an event with given report by notifying all subscribers of this event
+  /// @brief triggers an event with given report by notifying all subscribers of this event. The
+  /// notifications are queued for asynchronous delivery, so this never waits on the network. The
+  /// reported states are aggregated into the next PeriodicComponentReport.
   /// @param report the report to notify about
   void fire_event(const BICEPS::MM::EpisodicComponentReport& report);
 
+  /// @brief gets the counters of notifications that were dropped or coalesced
+  /// @return the notification statistics
+  NotificationDispatcher::Statistics get_notification_statistics() const;
+
 private:
   /// @brief SubscriptionInformation stores stateful information about a subscription
   struct SubscriptionInformation
   {
     /// the address of the subscriber
     const WS::ADDRESSING::EndpointReferenceType notify_to;
+    /// the address to send a SubscriptionEnd to, if the subscription ends unexpectedly
+    const WS::EVENTING::Subscribe::EndToOptional end_to;
+    /// the endpoint reference of the subscription manager holding this subscription
+    const WS::ADDRESSING::EndpointReferenceType subscription_manager;
     /// the ws eventing filter of this subscripiton
     const WS::EVENTING::FilterType filter;
+    /// sorted descriptor handles the reports are restricted to, empty if all are reported
+    const std::vector<std::string> handles;
     /// the time this subscription is valid for
     Duration::TimePoint expiration_time;
+    /// the slot of the expiry wheel this subscription is due in. Entries in other slots are stale
+    std::size_t expiry_slot;
   };
 
-  /// mutex protecting subscriptions_ map
+  /// @brief the active subscriptions, identifier->subscription
+  using Subscriptions = std::map<std::string, SubscriptionInformation>;
+
+  /// mutex protecting subscriptions_ map, routes_ and the expiry wheel
   mutable std::mutex subscription_mutex_;
   /// active subscriptions of the subscriber with a unique identifier
-  std::map<std::string, SubscriptionInformation> subscriptions_;
-  /// a pointer to the SessionManager implementation
-  SessionManager session_manager_;
+  Subscriptions subscriptions_;
+  /// the subscriptions whose filter contains an action, action->subscriptions. Kept in sync with
+  /// subscriptions_, so notifying about an event only visits its subscribers
+  std::unordered_map<std::string, std::vector<Subscriptions::iterator>> routes_;
+  /// the pool of client sessions shared with the discovery service
+  std::shared_ptr<SessionManager> session_manager_;
+  /// delivers notifications asynchronously to the subscribers
+  NotificationDispatcher dispatcher_;
+  /// the interval in which expired subscriptions are removed
+  static constexpr std::chrono::seconds EXPIRY_TICK{1};
+  /// number of slots of the expiry wheel, i.e. the number of ticks until it wraps around
+  static constexpr std::size_t EXPIRY_WHEEL_SLOTS{64};
+  /// whether subscribers with an EndTo address get a SubscriptionEnd when their subscription
+  /// expires. WS-Eventing does not require it, as the subscriber knows the expiration time.
+  static constexpr bool END_EXPIRED_SUBSCRIPTIONS{false};
+  /// hashed timer wheel of subscription identifiers, one slot per tick. A subscription is due in
+  /// the slot of its expiration time, or in the last slot of the current rotation if it expires
+  /// later. Renewed and removed subscriptions are not searched in the wheel, but skipped when
+  /// their slot is due.
+  std::array<std::vector<std::string>, EXPIRY_WHEEL_SLOTS> expiry_wheel_;
+  /// the slot of the expiry wheel processed last
+  std::size_t expiry_slot_{0};
+  /// asio IO context driving the expiry and periodic report timers
+  asio::io_context timer_context_;
+  /// timer triggering each tick of the expiry wheel
+  asio::steady_timer expiry_timer_;
+
+  /// @brief PeriodicReport aggregates the states changed within one period of a periodic report
+  template <typename State>
+  struct PeriodicReport
+  {
+    /// @brief constructs a periodic report whose timer is not armed
+    /// @param interval the interval of the report, zero if disabled
+    /// @param context the io context running the timer
+    PeriodicReport(const std::chrono::milliseconds interval, asio::io_context& context)
+      : interval(interval)
+      , timer(context)
+    {
+    }
+
+    /// the interval of the report, zero if disabled
+    const std::chrono::milliseconds interval;
+    /// timer triggering the report at the end of each period, armed while the report is active
+    asio::steady_timer timer;
+    /// whether the report has subscribers, only then states are aggregated
+    std::atomic<bool> active{false};
+    /// incremented on the timer thread whenever the report is started or stopped, to discard
+    /// periods which completed before the timer was cancelled
+    std::size_t generation{0};
+    /// latest states changed in the current period, descriptor handle->state
+    std::map<std::string, std::shared_ptr<const State>> states;
+    /// mdib version of the latest change in the current period
+    unsigned long mdib_version{0};
+  };
+  /// mutex protecting the states aggregated by the periodic reports
+  std::mutex periodic_report_mutex_;
+  /// the metric states aggregated for the next PeriodicMetricReport
+  PeriodicReport<BICEPS::PM::AbstractMetricState> periodic_metric_report_;
+  /// the component states aggregated for the next PeriodicComponentReport
+  PeriodicReport<BICEPS::PM::AbstractDeviceComponentState> periodic_component_report_;
+  /// thread running the timer context
+  std::thread timer_thread_;
   /// all allowed subscriptions of this manager
   std::vector<std::string> allowed_subscription_event_actions_{
       SDC::ACTION_OPERATION_INVOKED_REPORT,
@@ -86,6 +211,101 @@ private:
       SDC::ACTION_WAVEFORM_STREAM,
   };
 
+  /// @brief creates the body of a notification reporting only the states of the given sorted
+  /// descriptor handles
+  using BodyFactory = std::function<MESSAGEMODEL::Body(const std::vector<std::string>& handles)>;
+
+  /// @brief serializes a notification and queues it for all subscribers of the given action.
+  /// Subscribers are grouped by the states their handle filter selects, so every distinct report
+  /// is built and serialized once, after subscription_mutex_ was released. Subscriptions which
+  /// cannot keep up are ended according to the overflow policy.
+  /// @param action the action of the notification
+  /// @param handles the descriptor handles of all states reported by the notification
+  /// @param make_body creates the body of the notification for a subset of the handles
+  void notify(const std::string& action, std::vector<std::string> handles,
+              const BodyFactory& make_body);
+
+  /// @brief gets the descriptor handles of all states in a report
+  /// @param report the report to get the handles of
+  /// @return the handles of the reported states
+  static std::vector<std::string> reported_handles(const BICEPS::MM::AbstractMetricReport& report);
+  static std::vector<std::string>
+  reported_handles(const BICEPS::MM::AbstractComponentReport& report);
+
+  /// @brief removes all states from a report except those of the given descriptor handles
+  /// @param report the report to filter
+  /// @param handles the sorted descriptor handles of the states to keep
+  static void retain_states(BICEPS::MM::AbstractMetricReport& report,
+                            const std::vector<std::string>& handles);
+  static void retain_states(BICEPS::MM::AbstractComponentReport& report,
+                            const std::vector<std::string>& handles);
+
+  /// @brief waits for the end of the current period of a periodic report
+  /// @param report the periodic report to wait for
+  /// @param send_report sends the report once the period ended
+  template <typename State>
+  void await_period(PeriodicReport<State>& report, void (SubscriptionManager::*send_report)());
+
+  /// @brief starts a periodic report when its first subscriber arrives and stops it when the last
+  /// one leaves
+  /// @param report the periodic report to start or stop
+  /// @param active whether the report has subscribers
+  /// @param send_report sends the report once a period ended
+  template <typename State>
+  void set_periodic_report_active(PeriodicReport<State>& report, bool active,
+                                  void (SubscriptionManager::*send_report)());
+
+  /// @brief starts or stops the periodic report of an action, if it is one
+  /// @param action the action whose subscribers changed
+  /// @param active whether the action has subscribers
+  void set_periodic_report_active(const std::string& action, bool active);
+
+  /// @brief sends the metric states changed in the last period to all subscribers of periodic
+  /// metric reports
+  void send_periodic_metric_report();
+
+  /// @brief sends the component states changed in the last period to all subscribers of periodic
+  /// component reports
+  void send_periodic_component_report();
+
+  /// @brief resolves a handle filter to the descriptor handles it selects. MDS, VMD, channel,
+  /// SCO and system context handles select all descriptors below them.
+  /// @param handle_filter the handles requested by a subscriber
+  /// @param md_description the descriptors to resolve the handles in
+  /// @return the sorted selected handles
+  static std::vector<std::string>
+  resolve_handle_filter(const WS::EVENTING::Subscribe::HandleFilterType& handle_filter,
+                        const BICEPS::PM::MdDescription& md_description);
+
+  /// @brief removes a subscription and sends a SubscriptionEnd to its EndTo address, if present.
+  /// subscription_mutex_ has to be held.
+  /// @param subscription the subscription to end
+  /// @param status the WS-Eventing status why the subscription ended
+  /// @param reason a human readable reason why the subscription ended
+  void end_subscription(Subscriptions::iterator subscription, const std::string& status,
+                        const std::string& reason);
+
+  /// @brief adds a subscription to the routes of all actions in its filter. subscription_mutex_
+  /// has to be held.
+  /// @param subscription the subscription to route events to
+  void add_routes(Subscriptions::iterator subscription);
+
+  /// @brief removes a subscription from the routes and from the active subscriptions.
+  /// subscription_mutex_ has to be held.
+  /// @param subscription the subscription to erase
+  void erase_subscription(Subscriptions::iterator subscription);
+
+  /// @brief puts a subscription into the slot of the expiry wheel its expiration time is due in.
+  /// subscription_mutex_ has to be held.
+  /// @param subscription the subscription to schedule
+  void schedule_expiry(Subscriptions::iterator subscription);
+
+  /// @brief waits for the next tick of the expiry wheel
+  void await_expiry_tick();
+
+  /// @brief advances the expiry wheel by one slot and ends all subscriptions expired in it
+  void expire_subscriptions();
+
   /// @brief prints all current subscriptions to DEBUG Log
   void print_subscriptions() const;
 };
@@ -7,21 +7,62 @@
 
 Request::Request(std::string msg)
   : message_(std::move(msg))
+  , data_(message_.data())
+{
+}
+
+Request::Request(char* message)
+  : data_(message)
 {
 }
 
 const MESSAGEMODEL::Envelope& Request::get_envelope()
+{
+  get_body();
+  return *envelope_;
+}
+
+const MESSAGEMODEL::Header& Request::get_header()
 {
   if (envelope_ == nullptr)
   {
     parse();
   }
-  return *envelope_;
+  return envelope_->header;
+}
+
+const MESSAGEMODEL::Body& Request::get_body()
+{
+  if (envelope_ == nullptr)
+  {
+    parse();
+  }
+  if (body_decoded_)
+  {
+    return envelope_->body;
+  }
+  auto* body_node = envelope_node_->first_node("Body", MDPWS::WS_NS_SOAP_ENVELOPE);
+  if (body_node == nullptr)
+  {
+    LOG(LogLevel::ERROR, "Cannot find soap body node in received message!");
+    throw SoapFault();
+  }
+  try
+  {
+    envelope_->body = MESSAGEMODEL::Body(*body_node);
+  }
+  catch (ExpectedElement& e)
+  {
+    LOG(LogLevel::ERROR, "ExpectedElement " << e.ns() << ":" << e.name() << " not encountered");
+    throw SoapFault();
+  }
+  body_decoded_ = true;
+  return envelope_->body;
 }
 
 const char* Request::data() const
 {
-  return message_.c_str();
+  return data_;
 }
 
 void Request::respond(const MESSAGEMODEL::Envelope& response_envelope) const
@@ -38,18 +79,25 @@ void Request::respond(const std::string& msg) const
 
 void Request::parse()
 {
-  rapidxml::xml_document<> doc;
-  doc.parse<rapidxml::parse_fastest>(message_.data());
+  document_.parse<rapidxml::parse_fastest>(data_);
 
-  auto* envelope_node = doc.first_node("Envelope", MDPWS::WS_NS_SOAP_ENVELOPE);
-  if (envelope_node == nullptr)
+  envelope_node_ = document_.first_node("Envelope", MDPWS::WS_NS_SOAP_ENVELOPE);
+  if (envelope_node_ == nullptr)
   {
     LOG(LogLevel::ERROR, "Cannot find soap envelope node in received message!");
     throw SoapFault();
   }
+  auto* header_node = envelope_node_->first_node("Header", MDPWS::WS_NS_SOAP_ENVELOPE);
+  if (header_node == nullptr)
+  {
+    LOG(LogLevel::ERROR, "Cannot find soap header node in received message!");
+    throw SoapFault();
+  }
   try
   {
-    envelope_ = std::make_shared<MESSAGEMODEL::Envelope>(*envelope_node);
+    auto envelope = std::make_shared<MESSAGEMODEL::Envelope>();
+    envelope->header = MESSAGEMODEL::Header(*header_node);
+    envelope_ = std::move(envelope);
   }
   catch (ExpectedElement& e)
   {
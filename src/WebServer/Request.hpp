@@ -1,11 +1,14 @@
 #pragma once
 
+#include "rapidxml.hpp"
 #include <memory>
 #include <string>
 
 namespace MESSAGEMODEL
 {
   class Envelope;
+  struct Header;
+  struct Body;
 } // namespace MESSAGEMODEL
 
 /// @brief Request hold any information about a request a client sends to a server
@@ -15,6 +18,10 @@ public:
   /// @brief consturcts a new request based on a given message
   /// @param message the raw HTTP message content
   explicit Request(std::string msg);
+  /// @brief constructs a new request on a message held by the web server, which is parsed in
+  /// place instead of being copied
+  /// @param message the null-terminated raw HTTP message content, which must outlive the request
+  explicit Request(char* message);
   Request(const Request&) = delete;
   Request(Request&&) = delete;
   Request& operator=(const Request&) = delete;
@@ -22,10 +29,19 @@ public:
   virtual ~Request() = default;
 
 
-  /// @brief gets the parsed envelope inside this request
+  /// @brief gets the parsed envelope inside this request, decoding its header and body
   /// @return shared pointer to the envelope
   const MESSAGEMODEL::Envelope& get_envelope();
 
+  /// @brief gets the SOAP header of this request. Only the header is decoded, e.g. for routing
+  /// on the action, the body is left untouched.
+  /// @return reference to the decoded header
+  const MESSAGEMODEL::Header& get_header();
+
+  /// @brief gets the SOAP body of this request, decoding it on the first access
+  /// @return reference to the decoded body
+  const MESSAGEMODEL::Body& get_body();
+
 
   /// @brief enables direct access to raw string data
   /// @return const pointer to the raw data
@@ -46,11 +62,19 @@ private:
   /// @param msg the string to send
   virtual void send_response(const std::string& msg) const = 0;
 
-  /// @brief parses the content of this request's raw message
+  /// @brief parses the XML of this request's raw message and decodes the SOAP header
   void parse();
 
-  /// contains the parsed envelope of this request
+  /// the XML document of the raw message, kept for decoding the body on demand
+  rapidxml::xml_document<> document_;
+  /// the SOAP envelope node inside document_
+  rapidxml::xml_node<>* envelope_node_{nullptr};
+  /// contains the parsed envelope of this request, the body is decoded once body_decoded_ is set
   std::shared_ptr<MESSAGEMODEL::Envelope> envelope_{nullptr};
-  /// the raw message string
+  /// whether the body of envelope_ is decoded
+  bool body_decoded_{false};
+  /// the raw message string, if it is owned by this request
   std::string message_;
+  /// the raw message parsed in place, either message_ or a buffer of the web server
+  char* data_;
 };
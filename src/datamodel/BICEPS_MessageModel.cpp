@@ -32,6 +32,11 @@ namespace BICEPS::MM
   {
   }
 
+  PeriodicMetricReport::PeriodicMetricReport(const PM::MdibVersionGroup& mdib_version_group)
+    : AbstractMetricReport(mdib_version_group)
+  {
+  }
+
   AbstractSet::AbstractSet(SetKind kind, OperationHandleRefType operation_handle_ref)
     : operation_handle_ref(std::move(operation_handle_ref))
     , kind_(kind)
@@ -138,6 +143,11 @@ namespace BICEPS::MM
   {
   }
 
+  PeriodicComponentReport::PeriodicComponentReport(const PM::MdibVersionGroup& mdib_version_group)
+    : AbstractComponentReport(mdib_version_group)
+  {
+  }
+
   OperationInvokedReportPart::OperationInvokedReportPart(
       OperationHandleRefType operation_handle_ref, InvocationInfoType invocation_info,
       InvocationSourceType invocation_source)
@@ -153,4 +163,9 @@ namespace BICEPS::MM
     , report_part(std::move(report_part))
   {
   }
+
+  WaveformStream::WaveformStream(const PM::MdibVersionGroup& mdib_version_group)
+    : AbstractReport(mdib_version_group)
+  {
+  }
 } // namespace BICEPS::MM
\ No newline at end of file
@@ -40,7 +40,7 @@ namespace BICEPS::MM
 
   struct GetMdibResponse : public AbstractGetResponse
   {
-    using MdibType = PM::Mdib;
+    using MdibType = std::shared_ptr<const PM::Mdib>;
     MdibType mdib;
 
     explicit GetMdibResponse(PM::MdibVersionGroup mdib_version_group, MdibType mdib);
@@ -86,6 +86,11 @@ namespace BICEPS::MM
     explicit EpisodicMetricReport(const PM::MdibVersionGroup& mdib_version_group);
   };
 
+  struct PeriodicMetricReport : public AbstractMetricReport
+  {
+    explicit PeriodicMetricReport(const PM::MdibVersionGroup& mdib_version_group);
+  };
+
   using OperationHandleRef = PM::HandleRef;
 
   struct AbstractSet
@@ -208,6 +213,11 @@ namespace BICEPS::MM
     explicit EpisodicComponentReport(const PM::MdibVersionGroup& mdib_version_group);
   };
 
+  struct PeriodicComponentReport : public AbstractComponentReport
+  {
+    explicit PeriodicComponentReport(const PM::MdibVersionGroup& mdib_version_group);
+  };
+
   struct OperationInvokedReportPart : public AbstractReportPart
   {
     using OperationHandleRefType = PM::HandleRef;
@@ -237,4 +247,13 @@ namespace BICEPS::MM
                            ReportPartType report_part);
   };
 
+  struct WaveformStream : public AbstractReport
+  {
+    using StateType = std::shared_ptr<const PM::RealTimeSampleArrayMetricState>;
+    using StateSequence = std::vector<StateType>;
+    StateSequence state;
+
+    explicit WaveformStream(const PM::MdibVersionGroup& mdib_version_group);
+  };
+
 } // namespace BICEPS::MM
@@ -145,6 +145,22 @@ namespace BICEPS::PM
     return other->get_kind() == DescriptorKind::NUMERIC_METRIC_DESCRIPTOR;
   }
 
+  RealTimeSampleArrayMetricDescriptor::RealTimeSampleArrayMetricDescriptor(
+      const HandleType& handle, const UnitType& unit, const MetricCategoryType& metric_category,
+      const MetricAvailabilityType& metric_availability, const ResolutionType& resolution,
+      SamplePeriodType sample_period)
+    : AbstractMetricDescriptor(DescriptorKind::REAL_TIME_SAMPLE_ARRAY_METRIC_DESCRIPTOR, handle,
+                               unit, metric_category, metric_availability)
+    , resolution(resolution)
+    , sample_period(std::move(sample_period))
+  {
+  }
+
+  bool RealTimeSampleArrayMetricDescriptor::classof(const AbstractDescriptor* other)
+  {
+    return other->get_kind() == DescriptorKind::REAL_TIME_SAMPLE_ARRAY_METRIC_DESCRIPTOR;
+  }
+
   bool StringMetricDescriptor::classof(const AbstractDescriptor* other)
   {
     return other->get_kind() == DescriptorKind::STRING_METRIC_DESCRIPTOR;
@@ -430,6 +446,26 @@ namespace BICEPS::PM
     return other->get_kind() == StateKind::NUMERIC_METRIC_STATE;
   }
 
+  SampleArrayValue::SampleArrayValue(const MetricQuality& metric_quality)
+    : AbstractMetricValue(MetricKind::SAMPLE_ARRAY_METRIC, metric_quality)
+  {
+  }
+
+  bool SampleArrayValue::classof(const AbstractMetricValue* other)
+  {
+    return other->get_kind() == MetricKind::SAMPLE_ARRAY_METRIC;
+  }
+
+  RealTimeSampleArrayMetricState::RealTimeSampleArrayMetricState(DescriptorHandleType handle)
+    : AbstractMetricState(StateKind::REAL_TIME_SAMPLE_ARRAY_METRIC_STATE, std::move(handle))
+  {
+  }
+
+  bool RealTimeSampleArrayMetricState::classof(const AbstractState* other)
+  {
+    return other->get_kind() == StateKind::REAL_TIME_SAMPLE_ARRAY_METRIC_STATE;
+  }
+
   bool StringMetricValue::classof(const AbstractMetricValue* other)
   {
     return other->get_kind() == MetricKind::STRING_METRIC;
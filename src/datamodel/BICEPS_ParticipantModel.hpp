@@ -1,6 +1,8 @@
 #pragma once
 
+#include "ChunkedSequence.hpp"
 #include "ws-addressing.hpp"
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -162,6 +164,7 @@ namespace BICEPS::PM
       NUMERIC_METRIC_DESCRIPTOR,
       STRING_METRIC_DESCRIPTOR,
       ENUM_STRING_METRIC_DESCRIPTOR,
+      REAL_TIME_SAMPLE_ARRAY_METRIC_DESCRIPTOR,
       LAST_METRIC_DESCRIPTOR,
 
       OPERATION_DESCRIPTOR,
@@ -413,6 +416,25 @@ namespace BICEPS::PM
                             const MetricAvailabilityType&, const ResolutionType&);
   };
 
+  struct RealTimeSampleArrayMetricDescriptor : public AbstractMetricDescriptor
+  {
+    using TechnicalRangeType = Range;
+    using TechnicalRangeSequence = std::vector<TechnicalRangeType>;
+    TechnicalRangeSequence technical_range;
+
+    using ResolutionType = double;
+    ResolutionType resolution;
+
+    using SamplePeriodType = std::string;
+    SamplePeriodType sample_period;
+
+    static bool classof(const AbstractDescriptor* other);
+
+    RealTimeSampleArrayMetricDescriptor(const HandleType&, const UnitType&,
+                                        const MetricCategoryType&, const MetricAvailabilityType&,
+                                        const ResolutionType&, SamplePeriodType);
+  };
+
   struct StringMetricDescriptor : public AbstractMetricDescriptor
   {
     static bool classof(const AbstractDescriptor* other);
@@ -556,6 +578,7 @@ namespace BICEPS::PM
       NUMERIC_METRIC_STATE,
       STRING_METRIC_STATE,
       ENUM_STRING_METRIC_STATE,
+      REAL_TIME_SAMPLE_ARRAY_METRIC_STATE,
       LAST_METRIC_STATE,
     };
     StateKind get_kind() const;
@@ -879,7 +902,8 @@ namespace BICEPS::PM
     enum class MetricKind
     {
       NUMERIC_METRIC,
-      STRING_METRIC
+      STRING_METRIC,
+      SAMPLE_ARRAY_METRIC
     };
     MetricKind get_kind() const;
 
@@ -955,6 +979,32 @@ namespace BICEPS::PM
     explicit NumericMetricState(DescriptorHandleType handle);
   };
 
+  struct SampleArrayValue : public AbstractMetricValue
+  {
+    using SamplesType = std::vector<double>;
+    using SamplesOptional = std::optional<SamplesType>;
+    SamplesOptional samples;
+
+    static bool classof(const AbstractMetricValue* other);
+
+    explicit SampleArrayValue(const MetricQuality& metric_quality);
+  };
+
+  struct RealTimeSampleArrayMetricState : public AbstractMetricState
+  {
+    using MetricValueType = SampleArrayValue;
+    using MetricValueOptional = std::optional<MetricValueType>;
+    MetricValueOptional metric_value;
+
+    using PhysiologicalRangeType = Range;
+    using PhysiologicalRangeSequence = std::vector<PhysiologicalRangeType>;
+    PhysiologicalRangeSequence physiological_range;
+
+    static bool classof(const AbstractState* other);
+
+    explicit RealTimeSampleArrayMetricState(DescriptorHandleType handle);
+  };
+
   struct StringMetricValue : public AbstractMetricValue
   {
     using ValueType = std::string;
@@ -987,7 +1037,8 @@ namespace BICEPS::PM
   struct MdState
   {
     using StateType = std::shared_ptr<AbstractState>;
-    using StateSequence = std::vector<StateType>;
+    /// chunked, so that mdib generations derived from each other share unchanged states
+    using StateSequence = ChunkedSequence<StateType>;
     StateSequence state;
 
     using StateVersionType = unsigned int;
@@ -1014,8 +1065,9 @@ namespace BICEPS::PM
   struct Mdib
   {
     using MdDescriptionType = ::BICEPS::PM::MdDescription;
-    using MdDescriptionOptional = std::optional<MdDescriptionType>;
-    MdDescriptionOptional md_description;
+    /// immutable and shared between mdib generations, which only differ in their states
+    using MdDescriptionPointer = std::shared_ptr<const MdDescriptionType>;
+    MdDescriptionPointer md_description;
 
     using MdStateType = ::BICEPS::PM::MdState;
     using MdStateOptional = std::optional<MdStateType>;
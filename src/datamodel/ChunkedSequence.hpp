@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+/// @brief ChunkedSequence stores its elements in chunks of a fixed size which are shared between
+/// copies of the sequence. Copying a sequence only copies the pointers to its chunks. Replacing an
+/// element copies the chunk holding it if the chunk is still shared, so a sequence derived from
+/// another one shares all chunks it did not touch.
+/// @tparam T the type of the elements
+/// @tparam CHUNK_SIZE the number of elements per chunk
+template <typename T, std::size_t CHUNK_SIZE = 64>
+class ChunkedSequence
+{
+  using Chunk = std::vector<T>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /// @brief const_iterator iterates the elements of a sequence in order
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+    const_iterator(const ChunkedSequence* sequence, const size_type index)
+      : sequence_(sequence)
+      , index_(index)
+    {
+    }
+
+    reference operator*() const
+    {
+      return (*sequence_)[index_];
+    }
+    pointer operator->() const
+    {
+      return &(*sequence_)[index_];
+    }
+    const_iterator& operator++()
+    {
+      ++index_;
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      auto it = *this;
+      ++index_;
+      return it;
+    }
+    bool operator==(const const_iterator& other) const
+    {
+      return index_ == other.index_ && sequence_ == other.sequence_;
+    }
+    bool operator!=(const const_iterator& other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    /// the iterated sequence
+    const ChunkedSequence* sequence_{nullptr};
+    /// index of the current element
+    size_type index_{0};
+  };
+
+  /// @brief gets the number of elements
+  /// @return the number of elements
+  size_type size() const
+  {
+    return size_;
+  }
+
+  /// @brief returns whether the sequence holds no elements
+  /// @return whether the sequence is empty
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  /// @brief accesses an element
+  /// @param index the index of the element, which has to be less than size()
+  /// @return reference to the element
+  const T& operator[](const size_type index) const
+  {
+    return (*chunks_[index / CHUNK_SIZE])[index % CHUNK_SIZE];
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, size_);
+  }
+
+  /// @brief appends an element to the last chunk, starting a new chunk if it is full
+  /// @param value the element to append
+  void push_back(T value)
+  {
+    if (size_ % CHUNK_SIZE == 0)
+    {
+      chunks_.emplace_back(std::make_shared<Chunk>());
+      chunks_.back()->reserve(CHUNK_SIZE);
+    }
+    unshared_chunk(chunks_.size() - 1).emplace_back(std::move(value));
+    ++size_;
+  }
+
+  /// @brief replaces an element. Only the chunk holding the element is copied, if another
+  /// sequence shares it.
+  /// @param index the index of the element, which has to be less than size()
+  /// @param value the new element
+  void set(const size_type index, T value)
+  {
+    unshared_chunk(index / CHUNK_SIZE)[index % CHUNK_SIZE] = std::move(value);
+  }
+
+private:
+  /// the chunks holding the elements, all but the last one are full
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  /// the number of elements
+  size_type size_{0};
+
+  /// @brief gets a chunk for modification, copying it first if it is shared with another sequence
+  /// @param chunk_index the index of the chunk
+  /// @return reference to the chunk only referenced by this sequence
+  Chunk& unshared_chunk(const size_type chunk_index)
+  {
+    auto& chunk = chunks_[chunk_index];
+    // a chunk referenced only by this sequence cannot be reached through any other sequence
+    if (chunk.use_count() > 1)
+    {
+      chunk = std::make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+  }
+};
@@ -58,6 +58,9 @@ namespace MDPWS
   NameSpaceConstant WS_NS_METADATA_EXCHANGE = "http://schemas.xmlsoap.org/ws/2004/09/mex";
   NameSpaceConstant WS_NS_DISCOVERY = "http://docs.oasis-open.org/ws-dd/ns/discovery/2009/01";
   NameSpaceConstant WS_NS_EVENTING = "http://schemas.xmlsoap.org/ws/2004/08/eventing";
+  // extension of WS-Eventing Subscribe restricting a subscription to descriptor handles
+  NameSpaceConstant NS_MICROSDC_EVENTING = "https://github.com/Draegerwerk/microSDC/eventing";
+  NameSpaceConstant NS_MICROSDC_EVENTING_PREFIX = "msdc";
 
   MDPWSConstant WS_ADDRESSING_ANONYMOUS = "http://www.w3.org/2005/08/addressing/anonymous";
   MDPWSConstant WS_ADDRESSING_REPLY = "http://www.w3.org/2005/08/addressing/reply";
@@ -89,6 +92,8 @@ namespace MDPWS
       "http://schemas.xmlsoap.org/ws/2004/08/eventing/Unsubscribe";
   MDPWSConstant WS_ACTION_UNSUBSCRIBE_RESPONSE =
       "http://schemas.xmlsoap.org/ws/2004/08/eventing/UnsubscribeResponse";
+  MDPWSConstant WS_ACTION_SUBSCRIPTION_END =
+      "http://schemas.xmlsoap.org/ws/2004/08/eventing/SubscriptionEnd";
   MDPWSConstant WS_ACTION_GETSTATUS = "http://schemas.xmlsoap.org/ws/2004/08/eventing/GetStatus";
   MDPWSConstant WS_ACTION_GETSTATUS_RESPONSE =
       "http://schemas.xmlsoap.org/ws/2004/08/eventing/GetStatusResponse";
@@ -106,6 +111,12 @@ namespace MDPWS
 
   MDPWSConstant WS_EVENTING_DELIVERYMODE_PUSH =
       "http://schemas.xmlsoap.org/ws/2004/08/eventing/DeliveryModes/Push";
+  MDPWSConstant WS_EVENTING_STATUS_DELIVERY_FAILURE =
+      "http://schemas.xmlsoap.org/ws/2004/08/eventing/DeliveryFailure";
+  MDPWSConstant WS_EVENTING_STATUS_SOURCE_SHUTTING_DOWN =
+      "http://schemas.xmlsoap.org/ws/2004/08/eventing/SourceShuttingDown";
+  MDPWSConstant WS_EVENTING_STATUS_SOURCE_CANCELLING =
+      "http://schemas.xmlsoap.org/ws/2004/08/eventing/SourceCancelling";
   MDPWSConstant WS_EVENTING_FILTER_ACTION =
       "http://docs.oasis-open.org/ws-dd/ns/dpws/2009/01/Action";
 
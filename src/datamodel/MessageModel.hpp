@@ -122,6 +122,10 @@ namespace MESSAGEMODEL
     using RenewResponseOptional = std::optional<RenewResponseType>;
     RenewResponseOptional renew_response;
 
+    using SubscriptionEndType = WS::EVENTING::SubscriptionEnd;
+    using SubscriptionEndOptional = std::optional<SubscriptionEndType>;
+    SubscriptionEndOptional subscription_end;
+
     using UnsubscribeType = WS::EVENTING::Unsubscribe;
     using UnsubscribeOptional = std::optional<UnsubscribeType>;
     UnsubscribeOptional unsubscribe;
@@ -150,6 +154,18 @@ namespace MESSAGEMODEL
     using EpisodicComponentReportOptional = std::optional<EpisodicComponentReportType>;
     EpisodicComponentReportOptional episodic_component_report;
 
+    using PeriodicMetricReportType = BICEPS::MM::PeriodicMetricReport;
+    using PeriodicMetricReportOptional = std::optional<PeriodicMetricReportType>;
+    PeriodicMetricReportOptional periodic_metric_report;
+
+    using PeriodicComponentReportType = BICEPS::MM::PeriodicComponentReport;
+    using PeriodicComponentReportOptional = std::optional<PeriodicComponentReportType>;
+    PeriodicComponentReportOptional periodic_component_report;
+
+    using WaveformStreamType = BICEPS::MM::WaveformStream;
+    using WaveformStreamOptional = std::optional<WaveformStreamType>;
+    WaveformStreamOptional waveform_stream;
+
   private:
     void parse(const rapidxml::xml_node<>& node);
   };
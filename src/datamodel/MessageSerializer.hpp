@@ -3,9 +3,18 @@
 #include "MDPWSConstants.hpp"
 #include "MessageModel.hpp"
 #include "SDCConstants.hpp"
-#include <sstream>
+#include "XmlWriter.hpp"
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+/// @brief MessageSerializer writes messages as XML directly into a buffer. Types having an element
+/// of their own are written by serialize(). Abstract and content types are written into the element
+/// opened by the caller in two passes, serialize_attributes() and serialize_elements(), as XML
+/// requires all attributes of an element to precede its content. The constant parts of the
+/// envelope are pre-rendered once, so that only the header fields and the body are written per
+/// message.
 class MessageSerializer
 {
 public:
@@ -16,125 +25,158 @@ public:
   /**
    * @brief get the serialized string
    */
-  std::string str() const;
+  const std::string& str() const;
+  /**
+   * @brief move the serialized string out of this serializer without copying it
+   */
+  std::string release();
+  /**
+   * @brief limits the samples of SampleArrayValues to a number of fractional digits instead of
+   * writing their shortest round-trip fixed notation
+   * @param precision the number of fractional digits, or none for the round-trip representation
+   */
+  void set_sample_precision(std::optional<int> precision);
 
   void serialize(const MESSAGEMODEL::Envelope& message);
-  void serialize(rapidxml::xml_node<>* parent, const MESSAGEMODEL::Envelope& message);
-  void serialize(rapidxml::xml_node<>* parent, const MESSAGEMODEL::Header& header);
-  void serialize(rapidxml::xml_node<>* parent, const MESSAGEMODEL::Body& body);
-  void serialize(rapidxml::xml_node<>* parent, const WS::ADDRESSING::RelatesToType& relates_to);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const WS::ADDRESSING::EndpointReferenceType& endpoint_reference);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DISCOVERY::AppSequenceType& app_sequence);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DISCOVERY::HelloType& hello);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DISCOVERY::ByeType& bye);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DISCOVERY::ProbeMatchType& probe_match);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const WS::DISCOVERY::ProbeMatchesType& probe_matches);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const WS::DISCOVERY::ResolveMatchType& resolve_match);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const WS::DISCOVERY::ResolveMatchesType& resolve_matches);
-  void serialize(rapidxml::xml_node<>* parent, const WS::MEX::Metadata& metadata);
-  void serialize(rapidxml::xml_node<>* parent, const WS::MEX::MetadataSection& metadata_section);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DISCOVERY::ScopesType& scopes);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DPWS::ThisModelType& this_model);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DPWS::ThisDeviceType& this_device);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DPWS::Relationship& relationship);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DPWS::HostServiceType& host);
-  void serialize(rapidxml::xml_node<>* parent, const WS::DPWS::HostedServiceType& hosted);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::MdibVersionGroup& version_group);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::MM::GetMdibResponse& get_mdib_response);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::Mdib& mdib);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::MdDescription& md_description);
-
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::LocalizedText& localized_text);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::CodedValue& coded_value);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractDescriptor& abstract_descriptor);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractDeviceComponentDescriptor& device);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractComplexDeviceComponentDescriptor& complex_device);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::MdsDescriptor& mds_descriptor);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::Metadata& metadata);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::SystemContextDescriptor& system_context);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractContextDescriptor& context);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::PatientContextDescriptor& patient_context);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::LocationContextDescriptor& location_context);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::VmdDescriptor& vmd);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::ChannelDescriptor& channel);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractMetricDescriptor& abstract_metric_descriptor);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::Range& range);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::MdState& md_state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AbstractState& state);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractDeviceComponentState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::CalibrationInfo& info);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::CalibrationDocumentation& documentation);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::PhysicalConnectorInfo& info);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::SystemContextState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::ChannelState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::OperationGroup& operation_group);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::ScoState& state);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractComplexDeviceComponentState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::MdsState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::VmdState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AbstractMetricState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::NumericMetricState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::StringMetricState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::EnumStringMetricState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AbstractMultiState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AbstractContextState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::LocationContextState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::LocationDetail& location_detail);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AbstractMetricValue& metric_value);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::NumericMetricValue& metric_value);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::StringMetricValue& metric_value);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::MetricQuality& quality);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AbstractOperationState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::SetValueOperationState& state);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::SetStringOperationState& state);
+  /**
+   * @brief writes an envelope around a body rendered beforehand
+   * @param header the header of the envelope
+   * @param rendered_body the serialized content of the body
+   */
+  void serialize(const MESSAGEMODEL::Header& header, std::string_view rendered_body);
+  void serialize_elements(const MESSAGEMODEL::Header& header);
+  void serialize_elements(const MESSAGEMODEL::Body& body);
+  void serialize(const WS::ADDRESSING::RelatesToType& relates_to);
+  void serialize(const WS::ADDRESSING::EndpointReferenceType& endpoint_reference);
+  void serialize(const WS::DISCOVERY::AppSequenceType& app_sequence);
+  void serialize(const WS::DISCOVERY::HelloType& hello);
+  void serialize(const WS::DISCOVERY::ByeType& bye);
+  void serialize(const WS::DISCOVERY::ProbeMatchType& probe_match);
+  void serialize(const WS::DISCOVERY::ProbeMatchesType& probe_matches);
+  void serialize(const WS::DISCOVERY::ResolveMatchType& resolve_match);
+  void serialize(const WS::DISCOVERY::ResolveMatchesType& resolve_matches);
+  void serialize(const WS::MEX::Metadata& metadata);
+  void serialize(const WS::MEX::MetadataSection& metadata_section);
+  void serialize(const WS::DISCOVERY::ScopesType& scopes);
+  void serialize(const WS::DPWS::ThisModelType& this_model);
+  void serialize(const WS::DPWS::ThisDeviceType& this_device);
+  void serialize(const WS::DPWS::Relationship& relationship);
+  void serialize(const WS::DPWS::HostServiceType& host);
+  void serialize(const WS::DPWS::HostedServiceType& hosted);
+  void serialize_attributes(const BICEPS::PM::MdibVersionGroup& version_group);
+  void serialize(const BICEPS::MM::GetMdibResponse& get_mdib_response);
+  /**
+   * @brief writes a GetMdibResponse from parts of its mdib rendered beforehand
+   * @param get_mdib_response the response holding the mdib
+   * @param rendered_md_description the serialized pm:MdDescription element, if any
+   * @param rendered_states the serialized pm:State elements in the order of the MdState
+   */
+  void serialize(const BICEPS::MM::GetMdibResponse& get_mdib_response,
+                 std::string_view rendered_md_description,
+                 const std::vector<std::string>& rendered_states);
+  void serialize(const BICEPS::PM::Mdib& mdib);
+  void serialize(const BICEPS::PM::MdDescription& md_description);
 
-  void serialize(rapidxml::xml_node<>* parent,
-                 const WS::EVENTING::SubscribeResponse& subscribe_response);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const WS::ADDRESSING::ReferenceParametersType& reference_parameters);
-  void serialize(rapidxml::xml_node<>* parent, const WS::EVENTING::RenewResponse& renew_response);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::MM::AbstractSetResponse& set_response);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::MM::InvocationInfo& invocation_info);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::MM::EpisodicMetricReport& report);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::MM::MetricReportPart&);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::MM::EpisodicComponentReport& report);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::MM::ComponentReportPart&);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::ScoDescriptor& sco);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::AbstractOperationDescriptor& operation);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::SetStringOperationDescriptor& operation);
-  void serialize(rapidxml::xml_node<>* parent,
-                 const BICEPS::PM::SetValueOperationDescriptor& operation);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::InstanceIdentifier& identifier);
-  void serialize(rapidxml::xml_node<>* parent, const WS::EVENTING::ExpirationType& expiration);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::AllowedValue& allowed_value);
-  void serialize(rapidxml::xml_node<>* parent, const BICEPS::PM::Measurement& measurement);
+  void serialize_attributes(const BICEPS::PM::LocalizedText& localized_text);
+  void serialize_elements(const BICEPS::PM::LocalizedText& localized_text);
+  void serialize_attributes(const BICEPS::PM::CodedValue& coded_value);
+  void serialize_elements(const BICEPS::PM::CodedValue& coded_value);
+  void serialize_attributes(const BICEPS::PM::AbstractDescriptor& abstract_descriptor);
+  void serialize_elements(const BICEPS::PM::AbstractDescriptor& abstract_descriptor);
+  void serialize_attributes(const BICEPS::PM::AbstractDeviceComponentDescriptor& device);
+  void serialize_elements(const BICEPS::PM::AbstractDeviceComponentDescriptor& device);
+  void serialize_attributes(
+      const BICEPS::PM::AbstractComplexDeviceComponentDescriptor& complex_device);
+  void
+  serialize_elements(const BICEPS::PM::AbstractComplexDeviceComponentDescriptor& complex_device);
+  void serialize(const BICEPS::PM::MdsDescriptor& mds_descriptor);
+  void serialize(const BICEPS::PM::Metadata& metadata);
+  void serialize(const BICEPS::PM::SystemContextDescriptor& system_context);
+  void serialize_attributes(const BICEPS::PM::AbstractContextDescriptor& context);
+  void serialize_elements(const BICEPS::PM::AbstractContextDescriptor& context);
+  void serialize(const BICEPS::PM::PatientContextDescriptor& patient_context);
+  void serialize(const BICEPS::PM::LocationContextDescriptor& location_context);
+  void serialize(const BICEPS::PM::VmdDescriptor& vmd);
+  void serialize(const BICEPS::PM::ChannelDescriptor& channel);
+  void serialize(const BICEPS::PM::AbstractMetricDescriptor& abstract_metric_descriptor);
+  void serialize_attributes(const BICEPS::PM::Range& range);
+  void serialize(const BICEPS::PM::MdState& md_state);
+  void serialize_state(const BICEPS::PM::AbstractState& state);
+  void serialize_attributes(const BICEPS::PM::AbstractState& state);
+  void serialize_attributes(const BICEPS::PM::AbstractDeviceComponentState& state);
+  void serialize_elements(const BICEPS::PM::AbstractDeviceComponentState& state);
+  void serialize_attributes(const BICEPS::PM::CalibrationInfo& info);
+  void serialize_elements(const BICEPS::PM::CalibrationInfo& info);
+  void serialize_elements(const BICEPS::PM::CalibrationDocumentation& documentation);
+  void serialize_attributes(const BICEPS::PM::PhysicalConnectorInfo& info);
+  void serialize_elements(const BICEPS::PM::PhysicalConnectorInfo& info);
+  void serialize_attributes(const BICEPS::PM::SystemContextState& state);
+  void serialize_elements(const BICEPS::PM::SystemContextState& state);
+  void serialize_attributes(const BICEPS::PM::ChannelState& state);
+  void serialize_elements(const BICEPS::PM::ChannelState& state);
+  void serialize_elements(const BICEPS::PM::OperationGroup& operation_group);
+  void serialize_attributes(const BICEPS::PM::ScoState& state);
+  void serialize_elements(const BICEPS::PM::ScoState& state);
+  void serialize_attributes(const BICEPS::PM::AbstractComplexDeviceComponentState& state);
+  void serialize_elements(const BICEPS::PM::AbstractComplexDeviceComponentState& state);
+  void serialize_attributes(const BICEPS::PM::MdsState& state);
+  void serialize_elements(const BICEPS::PM::MdsState& state);
+  void serialize_attributes(const BICEPS::PM::VmdState& state);
+  void serialize_elements(const BICEPS::PM::VmdState& state);
+  void serialize_attributes(const BICEPS::PM::AbstractMetricState& state);
+  void serialize_attributes(const BICEPS::PM::NumericMetricState& state);
+  void serialize_elements(const BICEPS::PM::NumericMetricState& state);
+  void serialize_attributes(const BICEPS::PM::StringMetricState& state);
+  void serialize_elements(const BICEPS::PM::StringMetricState& state);
+  void serialize_attributes(const BICEPS::PM::EnumStringMetricState& state);
+  void serialize_elements(const BICEPS::PM::EnumStringMetricState& state);
+  void serialize_attributes(const BICEPS::PM::RealTimeSampleArrayMetricState& state);
+  void serialize_elements(const BICEPS::PM::RealTimeSampleArrayMetricState& state);
+  void serialize_attributes(const BICEPS::PM::AbstractMultiState& state);
+  void serialize_attributes(const BICEPS::PM::AbstractContextState& state);
+  void serialize_elements(const BICEPS::PM::AbstractContextState& state);
+  void serialize_attributes(const BICEPS::PM::LocationContextState& state);
+  void serialize_elements(const BICEPS::PM::LocationContextState& state);
+  void serialize(const BICEPS::PM::LocationDetail& location_detail);
+  void serialize_elements(const BICEPS::PM::AbstractMetricValue& metric_value);
+  void serialize_attributes(const BICEPS::PM::NumericMetricValue& metric_value);
+  void serialize_elements(const BICEPS::PM::NumericMetricValue& metric_value);
+  void serialize_attributes(const BICEPS::PM::StringMetricValue& metric_value);
+  void serialize_elements(const BICEPS::PM::StringMetricValue& metric_value);
+  void serialize_attributes(const BICEPS::PM::SampleArrayValue& metric_value);
+  void serialize_elements(const BICEPS::PM::SampleArrayValue& metric_value);
+  void serialize(const BICEPS::PM::MetricQuality& quality);
+  void serialize_attributes(const BICEPS::PM::AbstractOperationState& state);
+  void serialize_attributes(const BICEPS::PM::SetValueOperationState& state);
+  void serialize_attributes(const BICEPS::PM::SetStringOperationState& state);
+  void serialize_elements(const BICEPS::PM::SetStringOperationState& state);
 
-  template <typename T>
-  void append_to_string_attribute(rapidxml::xml_node<>* parent, const char* name, T value)
-  {
-    auto* str = xml_document_->allocate_string(std::to_string(value).c_str());
-    auto* attr = xml_document_->allocate_attribute(name, str);
-    parent->append_attribute(attr);
-  }
-  void append_attribute(rapidxml::xml_node<>* parent, const char* name, const std::string& value);
+  void serialize(const WS::EVENTING::SubscribeResponse& subscribe_response);
+  void serialize(const WS::ADDRESSING::ReferenceParametersType& reference_parameters);
+  void serialize(const WS::EVENTING::RenewResponse& renew_response);
+  void serialize(const WS::EVENTING::SubscriptionEnd& subscription_end);
+  void serialize(const BICEPS::MM::AbstractSetResponse& set_response);
+  void serialize(const BICEPS::MM::InvocationInfo& invocation_info);
+  void serialize(const BICEPS::MM::EpisodicMetricReport& report);
+  void serialize(const BICEPS::MM::MetricReportPart&);
+  void serialize(const BICEPS::MM::EpisodicComponentReport& report);
+  void serialize(const BICEPS::MM::PeriodicMetricReport& report);
+  void serialize(const BICEPS::MM::PeriodicComponentReport& report);
+  void serialize(const BICEPS::MM::WaveformStream& waveform_stream);
+  void serialize(const BICEPS::MM::ComponentReportPart&);
+  void serialize(const BICEPS::PM::ScoDescriptor& sco);
+  void serialize_attributes(const BICEPS::PM::AbstractOperationDescriptor& operation);
+  void serialize_elements(const BICEPS::PM::AbstractOperationDescriptor& operation);
+  void serialize_attributes(const BICEPS::PM::SetStringOperationDescriptor& operation);
+  void serialize_elements(const BICEPS::PM::SetStringOperationDescriptor& operation);
+  void serialize_attributes(const BICEPS::PM::SetValueOperationDescriptor& operation);
+  void serialize_elements(const BICEPS::PM::SetValueOperationDescriptor& operation);
+  void serialize_attributes(const BICEPS::PM::InstanceIdentifier& identifier);
+  void serialize(const WS::EVENTING::ExpirationType& expiration);
+  void serialize_elements(const Duration& duration);
+  void serialize(const BICEPS::PM::AllowedValue& allowed_value);
+  void serialize_attributes(const BICEPS::PM::Measurement& measurement);
+  void serialize_elements(const BICEPS::PM::Measurement& measurement);
 
   static std::string to_string(BICEPS::PM::SafetyClassification);
   static std::string to_string(const WS::DISCOVERY::UriListType& uri_list);
@@ -151,8 +193,22 @@ public:
   static std::string to_string(BICEPS::PM::MdsOperatingMode operating_mode);
   static std::string to_string(BICEPS::PM::CalibrationState calib_state);
   static std::string to_string(BICEPS::PM::CalibrationType calib_type);
-  static std::string to_string(Duration duration);
 
 private:
-  std::unique_ptr<rapidxml::xml_document<>> xml_document_;
+  /// the writer emitting the serialized message
+  XmlWriter writer_;
+  /// the number of fractional digits of samples, none for their round-trip representation
+  std::optional<int> sample_precision_;
+
+  /// @brief writes an element containing a given type in two passes
+  /// @param name the qualified name of the element
+  /// @param content the content of the element
+  template <typename T>
+  void serialize_element(const char* name, const T& content)
+  {
+    writer_.start_element(name);
+    serialize_attributes(content);
+    serialize_elements(content);
+    writer_.end_element();
+  }
 };
@@ -0,0 +1,185 @@
+#include "XmlWriter.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+XmlWriter::XmlWriter(const std::size_t capacity)
+{
+  buffer_.reserve(capacity);
+  open_elements_.reserve(16);
+}
+
+void XmlWriter::declaration()
+{
+  assert(buffer_.empty());
+  buffer_ += R"(<?xml version="1.0" encoding="utf-8"?>)";
+}
+
+void XmlWriter::start_element(const std::string_view name)
+{
+  close_start_tag();
+  buffer_ += '<';
+  buffer_ += name;
+  open_elements_.emplace_back(name);
+  start_tag_open_ = true;
+}
+
+void XmlWriter::end_element()
+{
+  assert(!open_elements_.empty());
+  if (start_tag_open_)
+  {
+    buffer_ += "/>";
+    start_tag_open_ = false;
+  }
+  else
+  {
+    buffer_ += "</";
+    buffer_ += open_elements_.back();
+    buffer_ += '>';
+  }
+  open_elements_.pop_back();
+}
+
+void XmlWriter::attribute(const std::string_view name, const std::string_view value)
+{
+  start_attribute(name);
+  append_escaped(value, true);
+  buffer_ += '"';
+}
+
+void XmlWriter::list_attribute(const std::string_view name, const std::vector<double>& values,
+                               const std::optional<int> precision)
+{
+  // room for the typical length of a formatted number and its separator, avoiding reallocations
+  buffer_.reserve(buffer_.size() + name.size() + 4 + values.size() * 12);
+  start_attribute(name);
+  for (auto value = values.begin(); value != values.end(); ++value)
+  {
+    if (value != values.begin())
+    {
+      buffer_ += ' ';
+    }
+    append_number(*value, precision);
+  }
+  buffer_ += '"';
+}
+
+void XmlWriter::text(const std::string_view text)
+{
+  if (text.empty())
+  {
+    return;
+  }
+  close_start_tag();
+  append_escaped(text, false);
+}
+
+void XmlWriter::text_element(const std::string_view name, const std::string_view text)
+{
+  start_element(name);
+  this->text(text);
+  end_element();
+}
+
+void XmlWriter::raw(const std::string_view markup)
+{
+  close_start_tag();
+  buffer_ += markup;
+}
+
+const std::string& XmlWriter::str() const
+{
+  return buffer_;
+}
+
+std::string XmlWriter::release()
+{
+  open_elements_.clear();
+  start_tag_open_ = false;
+  return std::move(buffer_);
+}
+
+void XmlWriter::close_start_tag()
+{
+  if (start_tag_open_)
+  {
+    buffer_ += '>';
+    start_tag_open_ = false;
+  }
+}
+
+void XmlWriter::start_attribute(const std::string_view name)
+{
+  assert(start_tag_open_ && "attributes have to precede the content of an element");
+  buffer_ += ' ';
+  buffer_ += name;
+  buffer_ += "=\"";
+}
+
+void XmlWriter::append_number(const double value, const std::optional<int> precision)
+{
+  // xs:decimal has no exponent, so values are always written in fixed notation
+  std::array<char, 64> chars{};
+  const auto result =
+      precision.has_value()
+          ? std::to_chars(chars.data(), chars.data() + chars.size(), value,
+                          std::chars_format::fixed, precision.value())
+          : std::to_chars(chars.data(), chars.data() + chars.size(), value,
+                          std::chars_format::fixed);
+  if (result.ec != std::errc())
+  {
+    append_long_decimal(value, precision);
+    return;
+  }
+  buffer_.append(chars.data(), result.ptr);
+}
+
+void XmlWriter::append_long_decimal(const double value, const std::optional<int> precision)
+{
+  // the integral part of a double has up to 309 digits, the shortest fractional part up to 324
+  std::string chars(330 + std::max(precision.value_or(0), 0), '\0');
+  const auto result =
+      precision.has_value()
+          ? std::to_chars(chars.data(), chars.data() + chars.size(), value,
+                          std::chars_format::fixed, precision.value())
+          : std::to_chars(chars.data(), chars.data() + chars.size(), value,
+                          std::chars_format::fixed);
+  buffer_.append(chars.data(), result.ptr);
+}
+
+void XmlWriter::append_escaped(const std::string_view value, const bool quote)
+{
+  auto begin = value.begin();
+  for (auto it = value.begin(); it != value.end(); ++it)
+  {
+    const char* reference = nullptr;
+    switch (*it)
+    {
+      case '<':
+        reference = "&lt;";
+        break;
+      case '>':
+        reference = "&gt;";
+        break;
+      case '&':
+        reference = "&amp;";
+        break;
+      case '"':
+        reference = "&quot;";
+        break;
+      case '\'':
+        reference = quote ? nullptr : "&apos;";
+        break;
+      default:
+        break;
+    }
+    if (reference != nullptr)
+    {
+      buffer_.append(begin, it);
+      buffer_ += reference;
+      begin = it + 1;
+    }
+  }
+  buffer_.append(begin, value.end());
+}
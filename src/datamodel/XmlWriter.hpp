@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/// @brief XmlWriter emits XML straight into a growable buffer without building a document tree.
+/// Start tags are kept open until the first child element or text is written, so attributes can be
+/// added until then. Elements without content are written as empty-element tags.
+class XmlWriter
+{
+  /// whether a type is written as number, excluding bool which is no xs number
+  template <typename T>
+  static constexpr bool is_number_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+public:
+  /// @brief constructs a new XmlWriter with an empty buffer
+  /// @param capacity the number of bytes to reserve in the buffer
+  explicit XmlWriter(std::size_t capacity = 0);
+
+  /// @brief writes the XML declaration
+  void declaration();
+
+  /// @brief writes the start tag of a new element, which is left open for attributes
+  /// @param name the qualified name of the element, which must outlive the element
+  void start_element(std::string_view name);
+
+  /// @brief writes the end tag of the element started last
+  void end_element();
+
+  /// @brief writes an attribute to the element started last, before any content was written
+  /// @param name the qualified name of the attribute
+  /// @param value the value of the attribute, which is escaped
+  void attribute(std::string_view name, std::string_view value);
+
+  /// @brief writes a numeric attribute to the element started last. The number is formatted
+  /// locale independently straight into the buffer.
+  /// @param name the qualified name of the attribute
+  /// @param value the value of the attribute
+  template <typename T, typename = std::enable_if_t<is_number_v<T>>>
+  void attribute(std::string_view name, T value)
+  {
+    start_attribute(name);
+    append_number(value);
+    buffer_ += '"';
+  }
+
+  /// @brief writes a list of numbers as white space separated attribute value. The numbers are
+  /// formatted locale independently straight into the buffer.
+  /// @param name the qualified name of the attribute
+  /// @param values the numbers to write
+  /// @param precision the number of fractional digits written, or none to write the shortest
+  /// fixed notation which reads back to the same value
+  void list_attribute(std::string_view name, const std::vector<double>& values,
+                      std::optional<int> precision = std::nullopt);
+
+  /// @brief writes character data to the element started last
+  /// @param text the text to write, which is escaped
+  void text(std::string_view text);
+
+  /// @brief writes a number as character data to the element started last
+  /// @param value the number to write
+  template <typename T, typename = std::enable_if_t<is_number_v<T>>>
+  void number(T value)
+  {
+    close_start_tag();
+    append_number(value);
+  }
+
+  /// @brief writes a complete element containing only text
+  /// @param name the qualified name of the element
+  /// @param text the text content of the element, which is escaped
+  void text_element(std::string_view name, std::string_view text);
+
+  /// @brief writes a complete element containing only a number
+  /// @param name the qualified name of the element
+  /// @param value the number content of the element
+  template <typename T, typename = std::enable_if_t<is_number_v<T>>>
+  void text_element(std::string_view name, T value)
+  {
+    start_element(name);
+    number(value);
+    end_element();
+  }
+
+  /// @brief appends pre-rendered markup as is, e.g. constant parts of a document
+  /// @param markup the well-formed markup to append
+  void raw(std::string_view markup);
+
+  /// @brief gets the XML written so far
+  /// @return reference to the buffer
+  const std::string& str() const;
+
+  /// @brief moves the written XML out of the writer, leaving it empty
+  /// @return the written XML
+  std::string release();
+
+private:
+  /// the written XML
+  std::string buffer_;
+  /// names of the elements started but not yet ended
+  std::vector<std::string_view> open_elements_;
+  /// whether the start tag of the element started last is still open for attributes
+  bool start_tag_open_{false};
+
+  /// @brief completes an open start tag before content is written
+  void close_start_tag();
+
+  /// @brief writes the name of an attribute and opens its quoted value
+  /// @param name the qualified name of the attribute
+  void start_attribute(std::string_view name);
+
+  /// @brief appends a number in decimal notation, floating point numbers in the shortest fixed
+  /// notation which reads back to the same value
+  /// @param value the number to append
+  template <typename T>
+  void append_number(T value)
+  {
+    // large enough for any integer and for floating point numbers of common magnitudes
+    std::array<char, 32> chars{};
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      // xs:decimal has no exponent, which the shortest representation might use
+      const auto result = std::to_chars(chars.data(), chars.data() + chars.size(), value,
+                                        std::chars_format::fixed);
+      if (result.ec != std::errc())
+      {
+        append_long_decimal(static_cast<double>(value), std::nullopt);
+        return;
+      }
+      buffer_.append(chars.data(), result.ptr);
+    }
+    else
+    {
+      const auto result = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+      buffer_.append(chars.data(), result.ptr);
+    }
+  }
+
+  /// @brief appends a number in fixed notation
+  /// @param value the number to append
+  /// @param precision the number of fractional digits, or none for the shortest round-trip form
+  void append_number(double value, std::optional<int> precision);
+
+  /// @brief appends a number in fixed notation which is too long to be formatted on the stack
+  /// @param value the number to append
+  /// @param precision the number of fractional digits, or none for the shortest round-trip form
+  void append_long_decimal(double value, std::optional<int> precision);
+
+  /// @brief appends a string replacing XML markup characters by entity references
+  /// @param value the string to append
+  /// @param quote whether the string is an attribute value, in which apostrophes are kept
+  void append_escaped(std::string_view value, bool quote);
+};
@@ -117,6 +117,17 @@ namespace WS::EVENTING
       {
         filter = std::make_optional<FilterType>(*entry);
       }
+      else if (strncmp(entry->name(), "HandleFilter", entry->name_size()) == 0 &&
+               strncmp(entry->xmlns(), ::MDPWS::NS_MICROSDC_EVENTING, entry->xmlns_size()) == 0)
+      {
+        // extract white space delimited handles
+        std::istringstream iss(std::string(entry->value(), entry->value_size()));
+        handle_filter = std::make_optional<HandleFilterType>();
+        for (std::string s; iss >> s;)
+        {
+          handle_filter->emplace_back(s);
+        }
+      }
     }
   }
 
@@ -145,6 +156,14 @@ namespace WS::EVENTING
     }
   }
 
+  // SubscriptionEnd
+  //
+  SubscriptionEnd::SubscriptionEnd(SubscriptionManagerType subscription_manager, StatusType status)
+    : subscription_manager(std::move(subscription_manager))
+    , status(std::move(status))
+  {
+  }
+
   // Unsubscribe
   //
   Unsubscribe::Unsubscribe(const rapidxml::xml_node<>& node) {}
@@ -65,6 +65,12 @@ namespace WS::EVENTING
     using FilterOptional = std::optional<FilterType>;
     FilterOptional filter;
 
+    /// descriptor handles the reports are restricted to. MDS, VMD and channel handles select
+    /// their whole subtree.
+    using HandleFilterType = std::vector<std::string>;
+    using HandleFilterOptional = std::optional<HandleFilterType>;
+    HandleFilterOptional handle_filter;
+
     explicit Subscribe(DeliveryType delivery);
     explicit Subscribe(const rapidxml::xml_node<>& node);
 
@@ -104,6 +110,21 @@ namespace WS::EVENTING
     ExpiresOptional expires;
   };
 
+  struct SubscriptionEnd
+  {
+    using SubscriptionManagerType = WS::ADDRESSING::EndpointReferenceType;
+    SubscriptionManagerType subscription_manager;
+
+    using StatusType = std::string;
+    StatusType status;
+
+    using ReasonType = std::string;
+    using ReasonOptional = std::optional<ReasonType>;
+    ReasonOptional reason;
+
+    SubscriptionEnd(SubscriptionManagerType subscription_manager, StatusType status);
+  };
+
   struct Unsubscribe
   {
     explicit Unsubscribe(const rapidxml::xml_node<>& node);
@@ -1,5 +1,4 @@
 #include "DiscoveryService.hpp"
-#include "ClientSession/ClientSession.hpp"
 #include "Log.hpp"
 #include "MicroSDC.hpp"
 #include "datamodel/ExpectedElement.hpp"
@@ -14,8 +13,10 @@ static constexpr const char* TAG = "DPWS";
 DiscoveryService::DiscoveryService(WS::ADDRESSING::EndpointReferenceType::AddressType epr,
                                    WS::DISCOVERY::QNameListType types,
                                    WS::DISCOVERY::UriListType x_addresses,
+                                   std::shared_ptr<SessionManager> session_manager,
                                    WS::DISCOVERY::HelloType::MetadataVersionType metadata_version)
-  : socket_(io_context_,
+  : session_manager_(std::move(session_manager))
+  , socket_(io_context_,
             asio::ip::udp::endpoint(asio::ip::udp::v4(), MDPWS::UDP_MULTICAST_DISCOVERY_PORT))
   , multicast_endpoint_(address_from_string(MDPWS::UDP_MULTICAST_DISCOVERY_IP_V4),
                         MDPWS::UDP_MULTICAST_DISCOVERY_PORT)
@@ -36,6 +37,11 @@ DiscoveryService::~DiscoveryService() noexcept
 
 void DiscoveryService::stop()
 {
+  // stop is called again on destruction
+  if (!thread_.joinable())
+  {
+    return;
+  }
   LOG(LogLevel::INFO, "Stopping...");
   send_bye();
   running_.store(false);
@@ -65,6 +71,7 @@ void DiscoveryService::configure_proxy(const NetworkConfig::DiscoveryProxyProtoc
                                        const std::string& proxy_address)
 {
   discovery_proxy_protocol_ = proxy_protocol;
+  discovery_proxy_session_ = nullptr;
   if (discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::UDP)
   {
     discovery_proxy_udp_endpoint_ = {address_from_string(proxy_address.c_str()),
@@ -73,7 +80,9 @@ void DiscoveryService::configure_proxy(const NetworkConfig::DiscoveryProxyProtoc
   else if (discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTP ||
            discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTPS)
   {
-    discovery_proxy_http_endpoint_ = proxy_address;
+    discovery_proxy_session_ = session_manager_->get_session(
+        proxy_address,
+        discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTPS);
   }
   if (running())
   {
@@ -224,7 +233,7 @@ void DiscoveryService::send_hello()
   // Serialize and send
   MessageSerializer serializer;
   serializer.serialize(*message);
-  auto msg = std::make_shared<std::string>(serializer.str());
+  auto msg = std::make_shared<std::string>(serializer.release());
   LOG(LogLevel::INFO, "Sending hello message...");
   const auto async_callback = [msg](const std::error_code& ec,
                                     const std::size_t bytes_transferred) {
@@ -246,18 +255,23 @@ void DiscoveryService::send_hello()
     socket_.async_send_to(asio::buffer(*msg), discovery_proxy_udp_endpoint_.value(),
                           async_callback);
   }
-  else if (discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTP)
+  else if (discovery_proxy_session_ != nullptr)
   {
-    auto session = ClientSessionFactory::produce(discovery_proxy_http_endpoint_, false);
-    session->send(*msg);
-  }
-  else if (discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTPS)
-  {
-    auto session = ClientSessionFactory::produce(discovery_proxy_http_endpoint_, true);
-    session->send(*msg);
+    send_to_proxy(msg);
   }
 }
 
+void DiscoveryService::send_to_proxy(std::shared_ptr<const std::string> message)
+{
+  // the session's thread must not be blocked, so the delivery is not awaited
+  discovery_proxy_session_->send_async(std::move(message), [](const bool delivered) {
+    if (!delivered)
+    {
+      LOG(LogLevel::ERROR, "Error while sending to discovery proxy");
+    }
+  });
+}
+
 void DiscoveryService::build_hello_message(MESSAGEMODEL::Envelope& envelope)
 {
   envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_HELLO);
@@ -290,7 +304,7 @@ void DiscoveryService::send_bye()
   // Serialize and send
   MessageSerializer serializer;
   serializer.serialize(*message);
-  auto msg = std::make_shared<std::string>(serializer.str());
+  auto msg = std::make_shared<std::string>(serializer.release());
   LOG(LogLevel::INFO, "Sending bye message...");
   const auto async_callback = [msg](const std::error_code& ec,
                                     const std::size_t bytes_transferred) {
@@ -312,15 +326,9 @@ void DiscoveryService::send_bye()
     socket_.async_send_to(asio::buffer(*msg), discovery_proxy_udp_endpoint_.value(),
                           async_callback);
   }
-  else if (discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTP)
-  {
-    auto session = ClientSessionFactory::produce(discovery_proxy_http_endpoint_, false);
-    session->send(*msg);
-  }
-  else if (discovery_proxy_protocol_ == NetworkConfig::DiscoveryProxyProtocol::HTTPS)
+  else if (discovery_proxy_session_ != nullptr)
   {
-    auto session = ClientSessionFactory::produce(discovery_proxy_http_endpoint_, true);
-    session->send(*msg);
+    send_to_proxy(msg);
   }
 }
 
@@ -352,7 +360,7 @@ void DiscoveryService::handle_probe(const MESSAGEMODEL::Envelope& envelope)
   MessageSerializer serializer;
   serializer.serialize(*response_message);
   LOG(LogLevel::INFO, "Sending ProbeMatch");
-  auto msg = std::make_shared<std::string>(serializer.str());
+  auto msg = std::make_shared<std::string>(serializer.release());
   socket_.async_send_to(
       asio::buffer(*msg), sender_endpoint_,
       [msg](const std::error_code& ec, const std::size_t bytes_transferred) {
@@ -377,7 +385,7 @@ void DiscoveryService::handle_resolve(const MESSAGEMODEL::Envelope& envelope)
   MessageSerializer serializer;
   serializer.serialize(*response_message);
   LOG(LogLevel::INFO, "Sending ResolveMatch");
-  auto msg = std::make_shared<std::string>(serializer.str());
+  auto msg = std::make_shared<std::string>(serializer.release());
   socket_.async_send_to(asio::buffer(*msg), sender_endpoint_,
                         [msg](const std::error_code& ec, const std::size_t bytes_transferred) {
                           if (ec)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ClientSession/SessionManager.hpp"
 #include "MessagingContext.hpp"
 #include "datamodel/MDPWSConstants.hpp"
 #include "datamodel/MessageModel.hpp"
@@ -15,8 +16,10 @@ class DiscoveryService
 {
 public:
   /// @brief Constructs DiscoveryService
+  /// @param session_manager the pool of client sessions to reach a HTTP(S) discovery proxy with
   DiscoveryService(WS::ADDRESSING::EndpointReferenceType::AddressType epr,
                    WS::DISCOVERY::QNameListType types, WS::DISCOVERY::UriListType x_addresses,
+                   std::shared_ptr<SessionManager> session_manager,
                    WS::DISCOVERY::HelloType::MetadataVersionType metadata_version = 1);
   DiscoveryService(const DiscoveryService&) = delete;
   DiscoveryService(DiscoveryService&&) = delete;
@@ -46,6 +49,8 @@ public:
   void set_location(const BICEPS::PM::LocationDetail& location_detail);
 
 private:
+  /// the pool of client sessions shared with the subscription manager
+  std::shared_ptr<SessionManager> session_manager_;
   /// whether this discovery service runs
   std::atomic_bool running_{false};
   /// thread of this host
@@ -58,8 +63,8 @@ private:
   asio::ip::udp::endpoint multicast_endpoint_;
   /// endpoint of the discovery proxy for udp, is empty, if no proxy is configured
   std::optional<asio::ip::udp::endpoint> discovery_proxy_udp_endpoint_;
-  /// endpoint of the discovery proxy for protocol types HTTP and HTTPS
-  std::string discovery_proxy_http_endpoint_;
+  /// pooled session to the discovery proxy for protocol types HTTP and HTTPS, kept for reuse
+  std::shared_ptr<ClientSessionInterface> discovery_proxy_session_;
   /// the protocol type of the discoveryProxy
   NetworkConfig::DiscoveryProxyProtocol discovery_proxy_protocol_{
       NetworkConfig::DiscoveryProxyProtocol::UDP};
@@ -111,6 +116,10 @@ private:
   /// @breif sends a bye message to the multicast endpoint
   void send_bye();
 
+  /// @brief queues a message for the HTTP(S) discovery proxy and logs if it cannot be delivered
+  /// @param message the serialized message to send
+  void send_to_proxy(std::shared_ptr<const std::string> message);
+
   /// @brief constructs a bye message into a given envelope
   /// @param[out] envelope the envelope to fill the bye message into
   void build_bye_message(MESSAGEMODEL::Envelope& envelope);
@@ -1,4 +1,5 @@
 #include "NetworkConfig.hpp"
+#include <algorithm>
 
 NetworkConfig::NetworkConfig(bool use_tls, std::string ip_address, std::uint16_t port)
   : use_tls_(use_tls)
@@ -42,3 +43,13 @@ NetworkConfig::DiscoveryProxyProtocol NetworkConfig::discovery_proxy_protocol()
 {
   return discovery_proxy_protocol_;
 }
+
+void NetworkConfig::set_worker_threads(const std::size_t worker_threads)
+{
+  worker_threads_ = std::max<std::size_t>(worker_threads, 1);
+}
+
+std::size_t NetworkConfig::worker_threads() const
+{
+  return worker_threads_;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -47,6 +48,14 @@ public:
   /// @return the protocol the discovery proxy is communicating
   DiscoveryProxyProtocol discovery_proxy_protocol() const;
 
+  /// @brief sets the number of threads handling requests concurrently. With more than one thread
+  /// StateHandler::request_state_change may be called concurrently.
+  /// @param worker_threads the number of threads, at least one
+  void set_worker_threads(std::size_t worker_threads);
+
+  /// @brief gets the number of threads handling requests concurrently
+  /// @return the configured number of threads
+  std::size_t worker_threads() const;
 
 private:
   /// whether to use TLS encrypted communication
@@ -59,4 +68,6 @@ private:
   std::optional<std::string> discovery_proxy_;
   /// the communication protocol of the discovery proxy
   DiscoveryProxyProtocol discovery_proxy_protocol_{DiscoveryProxyProtocol::UDP};
+  /// the number of threads handling requests
+  std::size_t worker_threads_{1};
 };
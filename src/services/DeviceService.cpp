@@ -3,13 +3,21 @@
 #include "MetadataProvider.hpp"
 #include "WebServer/Request.hpp"
 #include "datamodel/MDPWSConstants.hpp"
-#include "services/SoapFault.hpp"
+#include "datamodel/MessageSerializer.hpp"
 
 static constexpr const char* TAG = "DeviceService";
 
 DeviceService::DeviceService(std::shared_ptr<const MetadataProvider> metadata)
   : metadata_(std::move(metadata))
 {
+  add_action(MDPWS::WS_ACTION_GET,
+             [this](Request& req, const MESSAGEMODEL::Header& request_header) {
+               handle_get(req, request_header);
+             });
+  add_action(MDPWS::WS_ACTION_GET_METADATA_REQUEST,
+             [](Request& /*req*/, const MESSAGEMODEL::Header& /*request_header*/) {
+               LOG(LogLevel::WARNING, "HANDLE ACTION_GETMETADATA_REQUEST");
+             });
 }
 
 std::string DeviceService::get_uri() const
@@ -17,25 +25,12 @@ std::string DeviceService::get_uri() const
   return MetadataProvider::get_device_service_path();
 }
 
-void DeviceService::handle_request(std::unique_ptr<Request> req)
+void DeviceService::handle_get(Request& req, const MESSAGEMODEL::Header& request_header)
 {
-  const auto request_envelope = req->get_envelope();
-  const auto& soap_action = request_envelope.header.action;
-  if (soap_action == MDPWS::WS_ACTION_GET)
-  {
-    MESSAGEMODEL::Envelope response_envelope;
-    fill_response_message_from_request_message(response_envelope, request_envelope);
-    response_envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_GET_RESPONSE);
-    metadata_->fill_device_metadata(response_envelope);
-    req->respond(response_envelope);
-  }
-  else if (soap_action == MDPWS::WS_ACTION_GET_METADATA_REQUEST)
-  {
-    LOG(LogLevel::WARNING, "HANDLE ACTION_GETMETADATA_REQUEST");
-  }
-  else
-  {
-    LOG(LogLevel::ERROR, "Unknown soap action " << soap_action);
-    req->respond(SoapFault().envelope());
-  }
+  MESSAGEMODEL::Envelope response_envelope;
+  fill_response_message_from_request_message(response_envelope, request_header);
+  response_envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_GET_RESPONSE);
+  MessageSerializer serializer;
+  serializer.serialize(response_envelope.header, metadata_->rendered_device_metadata());
+  req.respond(serializer.str());
 }
@@ -14,9 +14,12 @@ public:
 
   std::string get_uri() const override;
 
-  void handle_request(std::unique_ptr<Request> req) override;
-
 private:
   /// a pointer to the metadata
   std::shared_ptr<const MetadataProvider> metadata_;
+
+  /// @brief handles a Get request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_get(Request& req, const MESSAGEMODEL::Header& request_header);
 };
@@ -0,0 +1,72 @@
+#include "EventSourceService.hpp"
+#include "MicroSDC.hpp"
+#include "SubscriptionManager.hpp"
+#include "WebServer/Request.hpp"
+#include "datamodel/ExpectedElement.hpp"
+#include "datamodel/MDPWSConstants.hpp"
+#include "datamodel/MessageModel.hpp"
+
+EventSourceService::EventSourceService(const MicroSDC& micro_sdc,
+                                       std::shared_ptr<SubscriptionManager> subscription_manager,
+                                       WS::ADDRESSING::URIType subscription_manager_address)
+  : micro_sdc_(micro_sdc)
+  , subscription_manager_(std::move(subscription_manager))
+  , subscription_manager_address_(std::move(subscription_manager_address))
+{
+  add_action(MDPWS::WS_ACTION_SUBSCRIBE,
+             [this](Request& req, const MESSAGEMODEL::Header& request_header) {
+               handle_subscribe(req, request_header);
+             });
+  add_action(MDPWS::WS_ACTION_RENEW,
+             [this](Request& req, const MESSAGEMODEL::Header& request_header) {
+               handle_renew(req, request_header);
+             });
+  add_action(MDPWS::WS_ACTION_UNSUBSCRIBE,
+             [this](Request& req, const MESSAGEMODEL::Header& request_header) {
+               handle_unsubscribe(req, request_header);
+             });
+}
+
+void EventSourceService::handle_subscribe(Request& req, const MESSAGEMODEL::Header& request_header)
+{
+  const auto mdib = micro_sdc_.get_mdib();
+  if (mdib->md_description == nullptr)
+  {
+    throw std::runtime_error("Cannot subscribe before the MdDescription is set!");
+  }
+  auto response = subscription_manager_->dispatch(req.get_body().subscribe.value(),
+                                                  subscription_manager_address_,
+                                                  *mdib->md_description);
+
+  MESSAGEMODEL::Envelope response_envelope;
+  fill_response_message_from_request_message(response_envelope, request_header);
+  response_envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_SUBSCRIBE_RESPONSE);
+  response_envelope.body.subscribe_response = std::move(response);
+  req.respond(response_envelope);
+}
+
+void EventSourceService::handle_renew(Request& req, const MESSAGEMODEL::Header& request_header)
+{
+  if (!request_header.identifier.has_value())
+  {
+    throw ExpectedElement("Identifier", MDPWS::WS_NS_EVENTING);
+  }
+  auto response = subscription_manager_->dispatch(req.get_body().renew.value(),
+                                                  request_header.identifier.value());
+  MESSAGEMODEL::Envelope response_envelope;
+  fill_response_message_from_request_message(response_envelope, request_header);
+  response_envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_RENEW_RESPONSE);
+  response_envelope.body.renew_response = std::move(response);
+  req.respond(response_envelope);
+}
+
+void EventSourceService::handle_unsubscribe(Request& req,
+                                            const MESSAGEMODEL::Header& request_header)
+{
+  subscription_manager_->dispatch(req.get_body().unsubscribe.value(),
+                                  request_header.identifier.value());
+  MESSAGEMODEL::Envelope response_envelope;
+  fill_response_message_from_request_message(response_envelope, request_header);
+  response_envelope.header.action = WS::ADDRESSING::URIType(MDPWS::WS_ACTION_UNSUBSCRIBE_RESPONSE);
+  req.respond(response_envelope);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SoapService.hpp"
+#include "datamodel/ws-addressing.hpp"
+#include <memory>
+
+class MicroSDC;
+class SubscriptionManager;
+
+/// @brief EventSourceService is a SOAP service acting as WS-Eventing event source. It handles the
+/// Subscribe, Renew and Unsubscribe actions of its clients.
+class EventSourceService : public SoapService
+{
+public:
+  /// @brief constructs a new EventSourceService and registers the eventing actions
+  /// @param micro_sdc a reference to the MicroSDC instance holding this service
+  /// @param subscription_manager a pointer to the SubscriptionManager maintaining the subscriptions
+  /// @param subscription_manager_address the address clients manage their subscriptions at
+  EventSourceService(const MicroSDC& micro_sdc,
+                     std::shared_ptr<SubscriptionManager> subscription_manager,
+                     WS::ADDRESSING::URIType subscription_manager_address);
+
+private:
+  /// a reference to the microSDC instance holding this service
+  const MicroSDC& micro_sdc_;
+  /// a pointer to the SubscriptionManager implementation to maintain client subscriptions
+  const std::shared_ptr<SubscriptionManager> subscription_manager_;
+  /// the address clients manage their subscriptions at
+  const WS::ADDRESSING::URIType subscription_manager_address_;
+
+  /// @brief handles a Subscribe request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_subscribe(Request& req, const MESSAGEMODEL::Header& request_header);
+
+  /// @brief handles a Renew request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_renew(Request& req, const MESSAGEMODEL::Header& request_header);
+
+  /// @brief handles an Unsubscribe request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_unsubscribe(Request& req, const MESSAGEMODEL::Header& request_header);
+};
@@ -8,7 +8,6 @@
 #include "datamodel/MDPWSConstants.hpp"
 #include "datamodel/MessageModel.hpp"
 #include "datamodel/MessageSerializer.hpp"
-#include "services/SoapFault.hpp"
 #include "uuid/UUIDGenerator.hpp"
 
 static constexpr const char* TAG = "GetService";
@@ -17,6 +16,14 @@ GetService::GetService(const MicroSDC& micro_sdc, std::shared_ptr<const Metadata
   : micro_sdc_(micro_sdc)
   , metadata_(std::move(metadata))
 {
+  add_action(MDPWS::WS_ACTION_GET_METADATA_REQUEST,
+             [this](Request& req, const MESSAGEMODEL::Header& request_header) {
+               handle_get_metadata(req, request_header);
+             });
+  add_action(SDC::ACTION_GET_MDIB_REQUEST,
+             [this](Request& req, const MESSAGEMODEL::Header& request_header) {
+               handle_get_mdib(req, request_header);
+             });
 }
 
 std::string GetService::get_uri() const
@@ -24,35 +31,75 @@ std::string GetService::get_uri() const
   return MetadataProvider::get_get_service_path();
 }
 
-void GetService::handle_request(std::unique_ptr<Request> req)
+void GetService::handle_get_metadata(Request& req, const MESSAGEMODEL::Header& request_header)
 {
-  const auto& request_envelope = req->get_envelope();
-  const auto& soap_action = request_envelope.header.action;
-  if (soap_action == MDPWS::WS_ACTION_GET_METADATA_REQUEST)
+  MESSAGEMODEL::Envelope response_envelope;
+  fill_response_message_from_request_message(response_envelope, request_header);
+  response_envelope.header.action =
+      WS::ADDRESSING::URIType(MDPWS::WS_ACTION_GET_METADATA_RESPONSE);
+  MessageSerializer serializer;
+  serializer.serialize(response_envelope.header, metadata_->rendered_get_service_metadata());
+  req.respond(serializer.str());
+}
+
+void GetService::handle_get_mdib(Request& req, const MESSAGEMODEL::Header& request_header)
+{
+  MESSAGEMODEL::Envelope response_envelope;
+  fill_response_message_from_request_message(response_envelope, request_header);
+  response_envelope.header.action = WS::ADDRESSING::URIType(SDC::ACTION_GET_MDIB_RESPONSE);
+  // pin one mdib generation so the version and the content are consistent
+  const auto body = get_mdib_response_body(micro_sdc_.get_mdib());
+  // only the addressing header differs between responses to the same generation
+  MessageSerializer serializer;
+  serializer.serialize(response_envelope.header, *body);
+  req.respond(serializer.str());
+}
+
+std::shared_ptr<const std::string>
+GetService::get_mdib_response_body(const std::shared_ptr<const BICEPS::PM::Mdib>& mdib)
+{
+  std::lock_guard<std::mutex> lock(get_mdib_cache_mutex_);
+  // the generation is compared rather than its mdib version, as context states like the location
+  // may be replaced without incrementing the mdib version
+  if (mdib == cached_mdib_)
   {
-    MESSAGEMODEL::Envelope response_envelope;
-    fill_response_message_from_request_message(response_envelope, request_envelope);
-    metadata_->fill_get_service_metadata(response_envelope);
-    response_envelope.header.action =
-        WS::ADDRESSING::URIType(MDPWS::WS_ACTION_GET_METADATA_RESPONSE);
-    req->respond(response_envelope);
+    return cached_get_mdib_response_;
   }
-  else if (soap_action == SDC::ACTION_GET_MDIB_REQUEST)
+  if (!cached_md_description_.has_value())
   {
-    MESSAGEMODEL::Envelope response_envelope;
-    fill_response_message_from_request_message(response_envelope, request_envelope);
-    response_envelope.header.action = WS::ADDRESSING::URIType(SDC::ACTION_GET_MDIB_RESPONSE);
-    WS::ADDRESSING::URIType sequence_id("0");
-    BICEPS::PM::MdibVersionGroup version_group{sequence_id};
-    version_group.mdib_version = micro_sdc_.get_mdib().mdib_version_group.mdib_version.value_or(0);
-    response_envelope.body.get_mdib_response =
-        std::make_optional<MESSAGEMODEL::Body::GetMdibResponseType>(version_group,
-                                                                    micro_sdc_.get_mdib());
-    req->respond(response_envelope);
+    MessageSerializer serializer;
+    if (mdib->md_description != nullptr)
+    {
+      serializer.serialize(*mdib->md_description);
+    }
+    cached_md_description_ = serializer.str();
   }
-  else
+  const BICEPS::PM::MdState::StateSequence no_states;
+  const auto& states = mdib->md_state.has_value() ? mdib->md_state->state : no_states;
+  cached_states_.resize(states.size());
+  cached_state_elements_.resize(states.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
   {
-    LOG(LogLevel::ERROR, "Unknown soap action " << soap_action);
-    req->respond(SoapFault().envelope());
+    // published states are immutable and never resubmitted (see MicroSDC::replace_md_state), so
+    // a state still at its slot is rendered the same
+    if (cached_states_[i] == states[i])
+    {
+      continue;
+    }
+    MessageSerializer serializer;
+    serializer.serialize_state(*states[i]);
+    cached_states_[i] = states[i];
+    // copied to fit, the serializer reserves far more than a single state needs
+    cached_state_elements_[i] = serializer.str();
   }
+
+  WS::ADDRESSING::URIType sequence_id("0");
+  BICEPS::PM::MdibVersionGroup version_group{sequence_id};
+  version_group.mdib_version = mdib->mdib_version_group.mdib_version.value_or(0);
+  MessageSerializer serializer;
+  serializer.serialize(BICEPS::MM::GetMdibResponse(version_group, mdib),
+                       cached_md_description_.value(), cached_state_elements_);
+  cached_mdib_ = mdib;
+  cached_get_mdib_response_ = std::make_shared<const std::string>(serializer.release());
+  return cached_get_mdib_response_;
 }
@@ -1,6 +1,12 @@
 #pragma once
 
 #include "SoapService.hpp"
+#include "datamodel/BICEPS_ParticipantModel.hpp"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 class MicroSDC;
 class MetadataProvider;
@@ -15,11 +21,41 @@ public:
   GetService(const MicroSDC& micro_sdc, std::shared_ptr<const MetadataProvider> metadata);
 
   std::string get_uri() const override;
-  void handle_request(std::unique_ptr<Request> req) override;
 
 private:
   /// a reference to the microSDC instance holding this service
   const MicroSDC& micro_sdc_;
   /// a pointer to the metadata
   const std::shared_ptr<const MetadataProvider> metadata_;
+
+  /// mutex protecting the cached GetMdibResponse
+  std::mutex get_mdib_cache_mutex_;
+  /// the mdib generation the cached GetMdibResponse body was rendered from
+  std::shared_ptr<const BICEPS::PM::Mdib> cached_mdib_;
+  /// the serialized body of the GetMdibResponse of cached_mdib_
+  std::shared_ptr<const std::string> cached_get_mdib_response_;
+  /// the serialized MdDescription, which does not change while this service exists
+  std::optional<std::string> cached_md_description_;
+  /// the states of cached_mdib_ in the order of its MdState
+  std::vector<std::shared_ptr<const BICEPS::PM::AbstractState>> cached_states_;
+  /// the serialized pm:State element of each of cached_states_
+  std::vector<std::string> cached_state_elements_;
+
+  /// @brief handles a GetMetadata request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_get_metadata(Request& req, const MESSAGEMODEL::Header& request_header);
+
+  /// @brief handles a GetMdib request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_get_mdib(Request& req, const MESSAGEMODEL::Header& request_header);
+
+  /// @brief gets the serialized body of the GetMdibResponse for an mdib generation. The body is
+  /// rendered once per generation and only states replaced since the previous generation are
+  /// serialized again.
+  /// @param mdib the mdib generation to respond with
+  /// @return the serialized GetMdibResponse
+  std::shared_ptr<const std::string>
+  get_mdib_response_body(const std::shared_ptr<const BICEPS::PM::Mdib>& mdib);
 };
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SoapService.hpp"
+#include "EventSourceService.hpp"
 #include "datamodel/BICEPS_MessageModel.hpp"
 #include <memory>
 
@@ -13,7 +13,7 @@ namespace BICEPS::MM
 } // namespace BICEPS::MM
 
 /// @brief SetService implements the SDC Set service
-class SetService : public SoapService
+class SetService : public EventSourceService
 {
 public:
   /// @brief constructs a new SetService from given metadata
@@ -24,19 +24,31 @@ public:
              std::shared_ptr<SubscriptionManager> subscription_manager);
 
   std::string get_uri() const override;
-  void handle_request(std::unique_ptr<Request> req) override;
 
 private:
   /// a reference to the microSDC instance holding this service
   MicroSDC* micro_sdc_;
   /// a pointer to the metadata
   const std::shared_ptr<const MetadataProvider> metadata_;
-  /// a pointer to the SubscriptionManager implementation to maintain client subscriptions
-  const std::shared_ptr<SubscriptionManager> subscription_manager_;
 
   /// @brief dispatches an incoming request to the respective handlers and processes it
   /// @param setValueRequest the SetValue request to dispatch
   /// @return the response to the request after processing completed
   BICEPS::MM::SetStringResponse dispatch(const BICEPS::MM::SetString& set_string_request);
   BICEPS::MM::SetValueResponse dispatch(const BICEPS::MM::SetValue& set_value_request);
+
+  /// @brief handles a GetMetadata request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_get_metadata(Request& req, const MESSAGEMODEL::Header& request_header);
+
+  /// @brief handles a SetValue request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_set_value(Request& req, const MESSAGEMODEL::Header& request_header);
+
+  /// @brief handles a SetString request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_set_string(Request& req, const MESSAGEMODEL::Header& request_header);
 };
@@ -1,11 +1,35 @@
 #include "SoapService.hpp"
+#include "Log.hpp"
 #include "MicroSDC.hpp"
+#include "WebServer/Request.hpp"
 #include "datamodel/MessageModel.hpp"
+#include "services/SoapFault.hpp"
 
-void SoapService::fill_response_message_from_request_message(MESSAGEMODEL::Envelope& envelope,
-                                                             const MESSAGEMODEL::Envelope& request)
+static constexpr const char* TAG = "SoapService";
+
+void SoapService::handle_request(std::unique_ptr<Request> req)
+{
+  const auto& request_header = req->get_header();
+  const auto& soap_action = request_header.action;
+  const auto handler = action_handlers_.find(soap_action);
+  if (handler == action_handlers_.end())
+  {
+    LOG(LogLevel::ERROR, "Unknown soap action " << soap_action);
+    req->respond(SoapFault().envelope());
+    return;
+  }
+  handler->second(*req, request_header);
+}
+
+void SoapService::add_action(std::string action, ActionHandler handler)
+{
+  action_handlers_[std::move(action)] = std::move(handler);
+}
+
+void SoapService::fill_response_message_from_request_message(
+    MESSAGEMODEL::Envelope& envelope, const MESSAGEMODEL::Header& request_header)
 {
   using MessageIDType = MESSAGEMODEL::Envelope::HeaderType::MessageIDType;
   envelope.header.message_id = MessageIDType(MicroSDC::calculate_message_id());
-  envelope.header.relates_to = WS::ADDRESSING::RelatesToType(request.header.message_id.value());
+  envelope.header.relates_to = WS::ADDRESSING::RelatesToType(request_header.message_id.value());
 }
@@ -2,19 +2,49 @@
 
 #include "ServiceInterface.hpp"
 #include <exception>
+#include <functional>
+#include <string>
+#include <unordered_map>
 
 namespace MESSAGEMODEL
 {
   class Envelope;
+  struct Header;
 } // namespace MESSAGEMODEL
 
-/// @brief SoapService defines an interface to a very general SOAP service
+/// @brief SoapService defines an interface to a very general SOAP service. Requests are dispatched
+/// to the handler registered for their SOAP action.
 class SoapService : public ServiceInterface
 {
 public:
+  /// @brief ActionHandler handles a request of one SOAP action. The body of the request is only
+  /// decoded if the handler accesses it.
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  using ActionHandler =
+      std::function<void(Request& req, const MESSAGEMODEL::Header& request_header)>;
+
+  /// @brief dispatches a request to the handler of its SOAP action. Only the SOAP header is decoded
+  /// for this, requests of unknown actions are answered with a SOAP fault.
+  /// @param req a pointer to the Request to be handled
+  void handle_request(std::unique_ptr<Request> req) override;
+
   /// @brief fills the given envelope with reply header information from a given request
   /// @param[out] envelope the envelope of the header to fill
-  /// @param request the request holding information of the reply data
-  static void fill_response_message_from_request_message(MESSAGEMODEL::Envelope& envelope,
-                                                         const MESSAGEMODEL::Envelope& request);
+  /// @param request_header the header of the request holding information of the reply data
+  static void
+  fill_response_message_from_request_message(MESSAGEMODEL::Envelope& envelope,
+                                             const MESSAGEMODEL::Header& request_header);
+
+protected:
+  /// @brief registers the handler of a SOAP action, replacing a handler registered before. Only
+  /// called by the constructors of derived services, as the handlers are read by the worker
+  /// threads of the web server without synchronization.
+  /// @param action the SOAP action to handle
+  /// @param handler the handler processing requests of this action
+  void add_action(std::string action, ActionHandler handler);
+
+private:
+  /// the handlers of the SOAP actions of this service, action->handler
+  std::unordered_map<std::string, ActionHandler> action_handlers_;
 };
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "SoapService.hpp"
+#include "EventSourceService.hpp"
 
 class MicroSDC;
 class MetadataProvider;
 class SubscriptionManager;
 
 /// @brief StateEventService implements the SDC StateEventService
-class StateEventService : public SoapService
+class StateEventService : public EventSourceService
 {
 public:
   /// @brief constructs a new StateEventService from given metadata
@@ -18,13 +18,13 @@ public:
                     std::shared_ptr<SubscriptionManager> subscription_manager);
 
   std::string get_uri() const override;
-  void handle_request(std::unique_ptr<Request> req) override;
 
 private:
-  /// a reference to the microSDC instance holding this service
-  const MicroSDC& micro_sdc_;
   /// a pointer to the metadata
   const std::shared_ptr<const MetadataProvider> metadata_;
-  /// a pointer to the SubscriptionManager implementation
-  const std::shared_ptr<SubscriptionManager> subscription_manager_;
+
+  /// @brief handles a GetMetadata request
+  /// @param req the request to respond to
+  /// @param request_header the decoded header of the request
+  void handle_get_metadata(Request& req, const MESSAGEMODEL::Header& request_header);
 };
@@ -0,0 +1,120 @@
+#include "WaveformStreamService.hpp"
+#include "Log.hpp"
+#include "MicroSDC.hpp"
+#include "SDCConstants.hpp"
+#include "datamodel/MDPWSConstants.hpp"
+#include "datamodel/MessageModel.hpp"
+#include "datamodel/MessageSerializer.hpp"
+#include <utility>
+
+static constexpr const char* TAG = "WaveformStreamService";
+
+WaveformStreamService::WaveformStreamService(const WaveformStreamConfig& config)
+  : frame_size_(std::max<std::size_t>(config.frame_size, 1))
+  , sample_precision_(config.sample_precision)
+  , work_guard_(asio::make_work_guard(io_context_))
+  , socket_(io_context_, asio::ip::udp::endpoint(asio::ip::udp::v4(), 0))
+{
+  asio::ip::address_v4::bytes_type address_bytes;
+  if (inet_pton(AF_INET, MDPWS::UDP_MULTICAST_STREAMING_IP_V4, &address_bytes) <= 0)
+  {
+    throw std::runtime_error("Cannot create ip address from string!");
+  }
+  multicast_endpoint_ = asio::ip::udp::endpoint(asio::ip::address_v4(address_bytes),
+                                                MDPWS::UDP_MULTICAST_STREAMING_PORT);
+  socket_.set_option(asio::ip::multicast::hops(MDPWS::UDP_MULTICAST_TIMETOLIVE));
+}
+
+WaveformStreamService::~WaveformStreamService() noexcept
+{
+  stop();
+}
+
+void WaveformStreamService::start()
+{
+  running_.store(true);
+  thread_ = std::thread([this]() {
+    LOG(LogLevel::INFO, "Start streaming waveforms to " << MDPWS::UDP_MULTICAST_STREAMING_IP_V4
+                                                        << ":"
+                                                        << MDPWS::UDP_MULTICAST_STREAMING_PORT);
+    io_context_.run();
+    LOG(LogLevel::INFO, "Shutting down waveform stream thread...");
+  });
+}
+
+void WaveformStreamService::stop()
+{
+  if (!running_.exchange(false))
+  {
+    return;
+  }
+  work_guard_.reset();
+  io_context_.stop();
+  thread_.join();
+  socket_.close();
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  frames_.clear();
+}
+
+bool WaveformStreamService::running() const
+{
+  return running_.load();
+}
+
+void WaveformStreamService::push_samples(
+    const std::string& descriptor_handle, const BICEPS::PM::SampleArrayValue::SamplesType& samples,
+    const BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version)
+{
+  if (!running_.load())
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  auto& frame = frames_[descriptor_handle];
+  frame.insert(frame.end(), samples.begin(), samples.end());
+  auto begin = frame.begin();
+  for (; static_cast<std::size_t>(frame.end() - begin) >= frame_size_; begin += frame_size_)
+  {
+    auto state = std::make_shared<BICEPS::PM::RealTimeSampleArrayMetricState>(descriptor_handle);
+    state->metric_value = BICEPS::PM::SampleArrayValue(
+        BICEPS::PM::MetricQuality(BICEPS::PM::MeasurementValidity::VLD));
+    state->metric_value->samples.emplace(begin, begin + frame_size_);
+    asio::post(io_context_, [this, state = std::move(state), mdib_version]() mutable {
+      send(std::move(state), mdib_version);
+    });
+  }
+  frame.erase(frame.begin(), begin);
+}
+
+void WaveformStreamService::send(
+    std::shared_ptr<const BICEPS::PM::RealTimeSampleArrayMetricState> state,
+    const BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version)
+{
+  MESSAGEMODEL::Envelope envelope;
+  envelope.header.action = WS::ADDRESSING::URIType(SDC::ACTION_WAVEFORM_STREAM);
+  envelope.header.message_id =
+      MESSAGEMODEL::Header::MessageIDType(MicroSDC::calculate_message_id());
+  envelope.body.waveform_stream =
+      BICEPS::MM::WaveformStream(BICEPS::PM::MdibVersionGroup{WS::ADDRESSING::URIType("0")});
+  envelope.body.waveform_stream->mdib_version_group.mdib_version = mdib_version;
+  envelope.body.waveform_stream->state.emplace_back(std::move(state));
+
+  MessageSerializer serializer;
+  serializer.set_sample_precision(sample_precision_);
+  serializer.serialize(envelope);
+  auto msg = std::make_shared<const std::string>(serializer.release());
+  if (msg->size() > MDPWS::MAX_UDP_ENVELOPE_SIZE)
+  {
+    LOG(LogLevel::WARNING, "WaveformStream of " << msg->size()
+                                                << " bytes exceeds the UDP envelope size");
+  }
+  socket_.async_send_to(
+      asio::buffer(*msg), multicast_endpoint_,
+      [msg](const std::error_code& ec, const std::size_t /*bytes_transferred*/) {
+        if (ec)
+        {
+          LOG(LogLevel::ERROR,
+              "Error while sending WaveformStream: ec " << ec.value() << ": " << ec.message());
+        }
+      });
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "datamodel/BICEPS_ParticipantModel.hpp"
+#include <asio.hpp>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief WaveformStreamConfig holds how samples are framed and encoded for streaming
+struct WaveformStreamConfig
+{
+  /// number of samples per frame and metric, the default keeps a frame within one UDP datagram
+  std::size_t frame_size{100};
+  /// number of fractional digits of the samples, none for their shortest round-trip
+  /// representation. Limiting it to the resolution of the metric shortens the frames.
+  std::optional<int> sample_precision;
+};
+
+/// @brief WaveformStreamService batches the samples of real time sample array metrics into frames
+/// of a fixed size and sends every completed frame as WaveformStream via SOAP-over-UDP multicast
+/// to 239.239.239.235:5555. Frames are sent from a dedicated thread, so streaming neither blocks
+/// the producer of the samples nor uses the HTTP sessions of the subscribers.
+class WaveformStreamService
+{
+public:
+  /// @brief Constructs a new WaveformStreamService
+  /// @param config the framing and encoding of the samples
+  explicit WaveformStreamService(const WaveformStreamConfig& config);
+  WaveformStreamService(const WaveformStreamService&) = delete;
+  WaveformStreamService(WaveformStreamService&&) = delete;
+  WaveformStreamService& operator=(const WaveformStreamService&) = delete;
+  WaveformStreamService& operator=(WaveformStreamService&&) = delete;
+  ~WaveformStreamService() noexcept;
+
+  /// @brief starts the thread sending the frames
+  void start();
+
+  /// @brief stops sending frames. Samples of incomplete frames are discarded.
+  void stop();
+
+  /// @brief Returns whether this streaming service is running
+  /// @return whether frames are sent
+  bool running() const;
+
+  /// @brief appends samples of a metric to its current frame and queues every completed frame
+  /// for sending
+  /// @param descriptor_handle the handle of the RealTimeSampleArrayMetricDescriptor
+  /// @param samples the new samples in chronological order
+  /// @param mdib_version the mdib version to report the frames with
+  void push_samples(const std::string& descriptor_handle,
+                    const BICEPS::PM::SampleArrayValue::SamplesType& samples,
+                    BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version);
+
+private:
+  /// the number of samples per frame and metric
+  const std::size_t frame_size_;
+  /// the number of fractional digits of the samples, none for their round-trip representation
+  const std::optional<int> sample_precision_;
+  /// whether this streaming service runs
+  std::atomic_bool running_{false};
+  /// asio IO context of the sending thread
+  asio::io_context io_context_;
+  /// keeps the IO context running while no frame is queued
+  asio::executor_work_guard<asio::io_context::executor_type> work_guard_;
+  /// sending socket for the frames
+  asio::ip::udp::socket socket_;
+  /// multicast endpoint 239.239.239.235:5555
+  asio::ip::udp::endpoint multicast_endpoint_;
+  /// thread sending the frames
+  std::thread thread_;
+  /// mutex protecting frames_
+  std::mutex frames_mutex_;
+  /// samples of the incomplete frame of each metric, descriptor handle->samples
+  std::map<std::string, BICEPS::PM::SampleArrayValue::SamplesType> frames_;
+
+  /// @brief serializes a frame and sends it to the multicast group. Runs on the sending thread.
+  /// @param state the state holding the samples of the frame
+  /// @param mdib_version the mdib version to report the frame with
+  void send(std::shared_ptr<const BICEPS::PM::RealTimeSampleArrayMetricState> state,
+            BICEPS::PM::MdibVersionGroup::MdibVersionType mdib_version);
+};
@@ -1,10 +1,15 @@
 #include "UUIDGenerator.hpp"
 #include <chrono>
+#include <functional>
+#include <thread>
 
 UUID UUIDGenerator::operator()()
 {
-  const auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-  std::mt19937 generator(seed);
+  // one engine per thread seeded once. Seeding an engine per call from the clock hands out equal
+  // UUIDs to threads calling at the same time.
+  thread_local std::mt19937 generator(
+      std::chrono::high_resolution_clock::now().time_since_epoch().count() ^
+      std::hash<std::thread::id>{}(std::this_thread::get_id()));
   std::uniform_int_distribution<> distribution;
 
   UUID::uuid_array_t bytes{};